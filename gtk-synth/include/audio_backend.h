@@ -1,12 +1,13 @@
 // audio_backend.h
 // Audio backend interface for GTK synthesizer
-// Supports PulseAudio and JACK
+// Supports PulseAudio, JACK and direct ALSA
 
 #ifndef AUDIO_BACKEND_H
 #define AUDIO_BACKEND_H
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 typedef enum {
     AUDIO_BACKEND_PULSEAUDIO,
@@ -16,11 +17,28 @@ typedef enum {
 
 typedef struct AudioBackend AudioBackend;
 
+// Counters since the backend was created
+typedef struct {
+    uint64_t frames;        // Frames rendered by the process callback
+    uint64_t xruns;         // Times the stream had to recover (JACK xrun, ALSA underrun or suspend)
+    uint64_t underruns;     // Of those, playback running dry
+    int period_size;        // Frames per device period as negotiated
+    int periods;            // Periods in the device buffer, 0 if unknown
+    int error;              // Error that stopped the stream (negative errno), 0 if none
+} AudioBackendStats;
+
 // Callback function type for audio processing
 // Called by the audio backend when it needs more samples
 typedef void (*AudioProcessCallback)(float* output, int num_samples, void* user_data);
 
+// Callback function type for MIDI input
+// Called on the audio thread, before the process callback, once for each
+// message received during that block; frame is the offset into the block
+typedef void (*AudioMidiCallback)(const uint8_t* data, size_t size, int frame, void* user_data);
+
 // Create and initialize audio backend
+// sample_rate and buffer_size are requests; backends driven by a server
+// (JACK) adopt the server's values, readable through the getters below
 AudioBackend* audio_backend_create(AudioBackendType type,
                                    int sample_rate,
                                    int buffer_size,
@@ -30,14 +48,22 @@ AudioBackend* audio_backend_create(AudioBackendType type,
 // Destroy audio backend
 void audio_backend_destroy(AudioBackend* backend);
 
+// Receive MIDI input, on backends that have it (JACK). Set before starting.
+void audio_backend_set_midi_callback(AudioBackend* backend, AudioMidiCallback callback);
+
 // Start/stop audio processing
 bool audio_backend_start(AudioBackend* backend);
 void audio_backend_stop(AudioBackend* backend);
 
 // Query backend status
+// is_running turns false on its own when the stream dies (ALSA device lost,
+// JACK server gone); the audio callback is no longer called after that
 bool audio_backend_is_running(AudioBackend* backend);
 float audio_backend_get_sample_rate(AudioBackend* backend);
 int audio_backend_get_buffer_size(AudioBackend* backend);
 const char* audio_backend_get_name(AudioBackend* backend);
 
+// Snapshot of the backend's counters; safe to call while running
+bool audio_backend_get_stats(AudioBackend* backend, AudioBackendStats* stats);
+
 #endif // AUDIO_BACKEND_H
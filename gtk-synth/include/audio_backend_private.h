@@ -0,0 +1,59 @@
+// audio_backend_private.h
+// Shared backend state and the operations each audio backend implements
+// Only included by src/audio/audio_backend*.c
+
+#ifndef AUDIO_BACKEND_PRIVATE_H
+#define AUDIO_BACKEND_PRIVATE_H
+
+#include "audio_backend.h"
+#include <stdatomic.h>
+
+typedef struct {
+    const char* name;
+    // Acquire the device or server connection and allocate backend->impl
+    bool (*open)(AudioBackend* backend);
+    // Release everything open() acquired; the backend is already stopped
+    void (*close)(AudioBackend* backend);
+    // Begin calling backend->callback; running is already true
+    bool (*start)(AudioBackend* backend);
+    // Stop calling it and wait until it has returned; running is already false
+    void (*stop)(AudioBackend* backend);
+} AudioBackendOps;
+
+struct AudioBackend {
+    AudioBackendType type;
+    const AudioBackendOps* ops;
+    float sample_rate;
+    int buffer_size;
+    AudioProcessCallback callback;
+    AudioMidiCallback midi_callback;
+    void* user_data;
+
+    atomic_bool running;        // Written by the control thread, polled by the audio thread;
+                                // cleared by the backend when the stream dies
+    bool started;               // start() succeeded and stop() is still due; control thread only
+    void* impl;                 // Backend-specific state
+
+    // Statistics, updated by the audio thread
+    atomic_uint_fast64_t frames;
+    atomic_uint_fast64_t xruns;
+    atomic_uint_fast64_t underruns;
+    atomic_int error;           // Error that stopped the stream (negative errno), 0 if none
+    int periods;                // Set by open()
+};
+
+// Render num_samples through the client callback and count them
+static inline void audio_backend_render(AudioBackend* backend, float* output, int num_samples) {
+    backend->callback(output, num_samples, backend->user_data);
+    atomic_fetch_add_explicit(&backend->frames, (uint_fast64_t)num_samples, memory_order_relaxed);
+}
+
+extern const AudioBackendOps audio_backend_pulse_ops;
+#ifdef HAVE_JACK
+extern const AudioBackendOps audio_backend_jack_ops;
+#endif
+#ifdef HAVE_ALSA
+extern const AudioBackendOps audio_backend_alsa_ops;
+#endif
+
+#endif // AUDIO_BACKEND_PRIVATE_H
@@ -11,7 +11,6 @@
 // Audio configuration
 #define DEFAULT_SAMPLE_RATE 44100
 #define DEFAULT_BUFFER_SIZE 256
-#define MAX_DELAY_LENGTH 8192
 
 // Interface types (0-11)
 typedef enum {
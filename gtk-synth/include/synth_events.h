@@ -0,0 +1,114 @@
+// synth_events.h
+// Lock-free UI -> audio thread event queue
+// Parameter changes and notes are stamped with the stream frame they should
+// take effect at, queued without locks, and applied sample-accurately by the
+// audio callback. The GTK thread never touches the engine while audio runs.
+
+#ifndef SYNTH_EVENTS_H
+#define SYNTH_EVENTS_H
+
+#include "pm_synth.h"
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Must be a power of two
+#define SYNTH_EVENT_QUEUE_CAPACITY 1024
+
+// MIDI messages the audio thread can schedule within one block
+#define SYNTH_MIDI_BLOCK_CAPACITY 256
+
+// One entry per pm_synth_set_* setter
+typedef enum {
+    SYNTH_PARAM_DC_LEVEL,
+    SYNTH_PARAM_NOISE_LEVEL,
+    SYNTH_PARAM_TONE_LEVEL,
+    SYNTH_PARAM_ATTACK,
+    SYNTH_PARAM_RELEASE,
+    SYNTH_PARAM_INTERFACE_TYPE,
+    SYNTH_PARAM_INTERFACE_INTENSITY,
+    SYNTH_PARAM_TUNING,
+    SYNTH_PARAM_RATIO,
+    SYNTH_PARAM_DELAY1_FEEDBACK,
+    SYNTH_PARAM_DELAY2_FEEDBACK,
+    SYNTH_PARAM_FILTER_FEEDBACK,
+    SYNTH_PARAM_FILTER_FREQUENCY,
+    SYNTH_PARAM_FILTER_Q,
+    SYNTH_PARAM_FILTER_SHAPE,
+    SYNTH_PARAM_LFO_FREQUENCY,
+    SYNTH_PARAM_MODULATION_DEPTH,
+    SYNTH_PARAM_REVERB_SIZE,
+    SYNTH_PARAM_REVERB_LEVEL,
+    SYNTH_PARAM_COUNT
+} SynthParam;
+
+typedef enum {
+    SYNTH_EVENT_PARAM,
+    SYNTH_EVENT_NOTE_ON,
+    SYNTH_EVENT_NOTE_OFF
+} SynthEventType;
+
+typedef struct {
+    uint64_t frame;         // Stream frame the event applies at
+    SynthEventType type;
+    int32_t id;             // SynthParam, or MIDI note for note events
+    float value;            // Parameter value (0-100, or InterfaceType)
+} SynthEvent;
+
+typedef struct {
+    SynthEvent events[SYNTH_EVENT_QUEUE_CAPACITY];
+    // Producer and consumer indices on separate cache lines
+    alignas(64) atomic_size_t write_index;
+    alignas(64) atomic_size_t read_index;
+
+    // Stream clock, published by the audio thread at the start of every
+    // block under a sequence lock so the UI reads a consistent set
+    alignas(64) atomic_uint clock_sequence;
+    atomic_uint_fast64_t block_frame;
+    atomic_int_fast64_t block_time_ns;
+    atomic_int block_length;
+
+    // Producer-only state
+    alignas(64) uint64_t last_frame;
+    float sample_rate;
+
+    // Consumer-only state
+    alignas(64) uint64_t stream_frame;
+    int sounding_note;
+    int midi_count;
+    SynthEvent midi_events[SYNTH_MIDI_BLOCK_CAPACITY];
+} SynthEventQueue;
+
+// Call before either thread uses the queue. block_size is the expected
+// block length until the audio thread has rendered its first block.
+void synth_event_queue_init(SynthEventQueue* queue, float sample_rate, int block_size);
+
+// Producer (UI thread). Events are stamped one block ahead of the audio
+// thread's current position plus the time elapsed since that block began,
+// so their spacing survives into the output. Returns false when the queue
+// is full; the event is dropped.
+bool synth_event_queue_push_param(SynthEventQueue* queue, SynthParam param, float value);
+bool synth_event_queue_push_note_on(SynthEventQueue* queue, int midi_note);
+bool synth_event_queue_push_note_off(SynthEventQueue* queue, int midi_note);
+
+// Consumer (audio thread). Schedules a raw MIDI message from the audio
+// backend at `frame` within the next block passed to process(). Note on and
+// note off are understood; anything else is ignored. Messages must arrive
+// in time order.
+void synth_event_queue_add_midi(SynthEventQueue* queue, const uint8_t* data,
+                                size_t size, int frame);
+
+// Consumer (audio thread). Renders num_samples into output, applying each
+// queued event and scheduled MIDI message at its frame within the block.
+// Events that arrive late are applied at the start of the block; queued
+// events beyond it stay queued.
+void synth_event_queue_process(SynthEventQueue* queue, PMSynthEngine* synth,
+                               float* output, int num_samples);
+
+// Consumer side, for when no audio thread is running: applies every queued
+// event immediately.
+void synth_event_queue_flush(SynthEventQueue* queue, PMSynthEngine* synth);
+
+#endif // SYNTH_EVENTS_H
@@ -0,0 +1,123 @@
+// audio_backend.c
+// Backend selection and the parts of the interface every backend shares
+
+#include "audio_backend_private.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+static const AudioBackendOps* backend_ops(AudioBackendType type) {
+    switch (type) {
+        case AUDIO_BACKEND_PULSEAUDIO: return &audio_backend_pulse_ops;
+#ifdef HAVE_JACK
+        case AUDIO_BACKEND_JACK: return &audio_backend_jack_ops;
+#endif
+#ifdef HAVE_ALSA
+        case AUDIO_BACKEND_ALSA: return &audio_backend_alsa_ops;
+#endif
+        default: return NULL;
+    }
+}
+
+AudioBackend* audio_backend_create(AudioBackendType type,
+                                   int sample_rate,
+                                   int buffer_size,
+                                   AudioProcessCallback callback,
+                                   void* user_data) {
+    const AudioBackendOps* ops = backend_ops(type);
+    if (!ops) {
+        fprintf(stderr, "Audio backend %d is not available in this build\n", (int)type);
+        return NULL;
+    }
+
+    AudioBackend* backend = (AudioBackend*)calloc(1, sizeof(AudioBackend));
+    if (!backend) return NULL;
+
+    backend->type = type;
+    backend->ops = ops;
+    backend->sample_rate = (float)sample_rate;
+    backend->buffer_size = buffer_size;
+    backend->callback = callback;
+    backend->midi_callback = NULL;
+    backend->user_data = user_data;
+    atomic_init(&backend->running, false);
+    atomic_init(&backend->frames, 0);
+    atomic_init(&backend->xruns, 0);
+    atomic_init(&backend->underruns, 0);
+    atomic_init(&backend->error, 0);
+    backend->periods = 0;
+
+    if (!ops->open(backend)) {
+        free(backend);
+        return NULL;
+    }
+
+    return backend;
+}
+
+void audio_backend_destroy(AudioBackend* backend) {
+    if (!backend) return;
+
+    if (backend->started) {
+        audio_backend_stop(backend);
+    }
+
+    backend->ops->close(backend);
+    free(backend);
+}
+
+void audio_backend_set_midi_callback(AudioBackend* backend, AudioMidiCallback callback) {
+    if (!backend || backend->started) return;
+    backend->midi_callback = callback;
+}
+
+bool audio_backend_start(AudioBackend* backend) {
+    if (!backend || backend->started) return false;
+
+    atomic_store(&backend->error, 0);
+    backend->running = true;
+
+    if (!backend->ops->start(backend)) {
+        backend->running = false;
+        return false;
+    }
+
+    backend->started = true;
+    return true;
+}
+
+void audio_backend_stop(AudioBackend* backend) {
+    // Also after the stream died by itself: the backend still needs stopping
+    if (!backend || !backend->started) return;
+
+    backend->running = false;
+    backend->ops->stop(backend);
+    backend->started = false;
+}
+
+bool audio_backend_is_running(AudioBackend* backend) {
+    return backend && backend->running;
+}
+
+float audio_backend_get_sample_rate(AudioBackend* backend) {
+    return backend ? backend->sample_rate : 0.0f;
+}
+
+int audio_backend_get_buffer_size(AudioBackend* backend) {
+    return backend ? backend->buffer_size : 0;
+}
+
+const char* audio_backend_get_name(AudioBackend* backend) {
+    return backend ? backend->ops->name : "None";
+}
+
+bool audio_backend_get_stats(AudioBackend* backend, AudioBackendStats* stats) {
+    if (!backend || !stats) return false;
+
+    stats->frames = atomic_load_explicit(&backend->frames, memory_order_relaxed);
+    stats->xruns = atomic_load_explicit(&backend->xruns, memory_order_relaxed);
+    stats->underruns = atomic_load_explicit(&backend->underruns, memory_order_relaxed);
+    stats->period_size = backend->buffer_size;
+    stats->periods = backend->periods;
+    stats->error = atomic_load_explicit(&backend->error, memory_order_relaxed);
+    return true;
+}
@@ -0,0 +1,318 @@
+// audio_backend_alsa.c
+// Direct ALSA backend implementation, for machines without a sound server
+// The render thread runs SCHED_FIFO and writes through the mmap interface:
+// the synth renders straight into the device ring when it takes mono float
+// samples, otherwise one period is rendered and converted in place.
+// Underruns and suspends are recovered from and counted.
+
+#define _DEFAULT_SOURCE
+
+#include "audio_backend_private.h"
+#include <alsa/asoundlib.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#define ALSA_DEFAULT_DEVICE "default"
+#define ALSA_PERIODS 2
+#define ALSA_RT_PRIORITY 70
+
+typedef struct {
+    snd_pcm_t* pcm;
+    snd_pcm_format_t format;
+    unsigned int channels;
+    snd_pcm_uframes_t period_size;
+    pthread_t audio_thread;
+    float* scratch;             // One period, when the device is not mono float
+} AlsaBackend;
+
+// ============================================================================
+// Render thread
+// ============================================================================
+
+// Counts the failure and brings the stream back to PREPARED/RUNNING.
+// Runs on the real-time thread, so failures are reported, not printed.
+static int alsa_recover(AudioBackend* backend, AlsaBackend* alsa, int err) {
+    if (err == -EPIPE) {
+        atomic_fetch_add_explicit(&backend->underruns, 1, memory_order_relaxed);
+    }
+    if (err == -EPIPE || err == -ESTRPIPE) {
+        atomic_fetch_add_explicit(&backend->xruns, 1, memory_order_relaxed);
+    }
+    return snd_pcm_recover(alsa->pcm, err, 1);
+}
+
+// The stream cannot be recovered (e.g. -ENODEV after an unplug): record why
+// and let the thread exit rather than spin at real-time priority
+static void* alsa_fail(AudioBackend* backend, int err) {
+    atomic_store(&backend->error, err);
+    atomic_store(&backend->running, false);
+    return NULL;
+}
+
+// Fills `frames` frames of the mmap areas starting at `offset`
+static void alsa_render(AudioBackend* backend, AlsaBackend* alsa,
+                        const snd_pcm_channel_area_t* areas,
+                        snd_pcm_uframes_t offset, snd_pcm_uframes_t frames) {
+    if (!alsa->scratch) {
+        // Mono float: the ring is the engine's output buffer
+        float* output = (float*)((char*)areas[0].addr + areas[0].first / 8) + offset;
+        audio_backend_render(backend, output, (int)frames);
+        return;
+    }
+
+    while (frames > 0) {
+        snd_pcm_uframes_t chunk = frames < alsa->period_size ? frames : alsa->period_size;
+        audio_backend_render(backend, alsa->scratch, (int)chunk);
+
+        for (unsigned int ch = 0; ch < alsa->channels; ch++) {
+            char* base = (char*)areas[ch].addr + areas[ch].first / 8;
+            const unsigned int step = areas[ch].step / 8;
+            for (snd_pcm_uframes_t i = 0; i < chunk; i++) {
+                char* dst = base + (offset + i) * step;
+                float sample = alsa->scratch[i];
+                if (alsa->format == SND_PCM_FORMAT_FLOAT_LE) {
+                    *(float*)dst = sample;
+                    continue;
+                }
+                // The engine can overshoot +-1; out-of-range float to int is undefined
+                if (sample > 1.0f) sample = 1.0f;
+                if (sample < -1.0f) sample = -1.0f;
+                if (alsa->format == SND_PCM_FORMAT_S32_LE) {
+                    *(int32_t*)dst = (int32_t)(sample * 2147483647.0);
+                } else {
+                    *(int16_t*)dst = (int16_t)(sample * 32767.0f);
+                }
+            }
+        }
+        offset += chunk;
+        frames -= chunk;
+    }
+}
+
+static void* alsa_thread_func(void* arg) {
+    AudioBackend* backend = (AudioBackend*)arg;
+    AlsaBackend* alsa = (AlsaBackend*)backend->impl;
+
+    while (backend->running) {
+        snd_pcm_sframes_t avail = snd_pcm_avail_update(alsa->pcm);
+        if (avail < 0) {
+            int err = alsa_recover(backend, alsa, (int)avail);
+            if (err < 0) return alsa_fail(backend, err);
+            continue;
+        }
+
+        if ((snd_pcm_uframes_t)avail < alsa->period_size) {
+            int err;
+            if (snd_pcm_state(alsa->pcm) == SND_PCM_STATE_PREPARED) {
+                // Buffer primed but below the start threshold: start by hand
+                err = snd_pcm_start(alsa->pcm);
+            } else {
+                err = snd_pcm_wait(alsa->pcm, 1000);
+            }
+            if (err < 0) {
+                err = alsa_recover(backend, alsa, err);
+                if (err < 0) return alsa_fail(backend, err);
+            }
+            continue;
+        }
+
+        // Fill one period, in two pieces when it wraps around the ring
+        snd_pcm_uframes_t remaining = alsa->period_size;
+        while (remaining > 0) {
+            const snd_pcm_channel_area_t* areas;
+            snd_pcm_uframes_t offset;
+            snd_pcm_uframes_t frames = remaining;
+
+            int err = snd_pcm_mmap_begin(alsa->pcm, &areas, &offset, &frames);
+            if (err < 0) {
+                err = alsa_recover(backend, alsa, err);
+                if (err < 0) return alsa_fail(backend, err);
+                break;
+            }
+
+            alsa_render(backend, alsa, areas, offset, frames);
+
+            snd_pcm_sframes_t committed = snd_pcm_mmap_commit(alsa->pcm, offset, frames);
+            if (committed < 0 || (snd_pcm_uframes_t)committed != frames) {
+                err = alsa_recover(backend, alsa, committed < 0 ? (int)committed : -EPIPE);
+                if (err < 0) return alsa_fail(backend, err);
+                break;
+            }
+            remaining -= frames;
+        }
+    }
+
+    return NULL;
+}
+
+// ============================================================================
+// Configuration
+// ============================================================================
+
+static bool alsa_configure(AudioBackend* backend, AlsaBackend* alsa) {
+    snd_pcm_hw_params_t* hw;
+    snd_pcm_sw_params_t* sw;
+    snd_pcm_hw_params_alloca(&hw);
+    snd_pcm_sw_params_alloca(&sw);
+
+    int err = snd_pcm_hw_params_any(alsa->pcm, hw);
+    if (err < 0) goto fail;
+
+    err = snd_pcm_hw_params_set_access(alsa->pcm, hw, SND_PCM_ACCESS_MMAP_INTERLEAVED);
+    if (err < 0) goto fail;
+
+    // Float is what the engine produces; integer formats cost a conversion
+    const snd_pcm_format_t formats[] = {
+        SND_PCM_FORMAT_FLOAT_LE, SND_PCM_FORMAT_S32_LE, SND_PCM_FORMAT_S16_LE
+    };
+    err = -EINVAL;
+    for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]) && err < 0; i++) {
+        err = snd_pcm_hw_params_set_format(alsa->pcm, hw, formats[i]);
+        if (err == 0) alsa->format = formats[i];
+    }
+    if (err < 0) goto fail;
+
+    alsa->channels = 1;
+    err = snd_pcm_hw_params_set_channels_near(alsa->pcm, hw, &alsa->channels);
+    if (err < 0) goto fail;
+
+    unsigned int rate = (unsigned int)backend->sample_rate;
+    err = snd_pcm_hw_params_set_rate_near(alsa->pcm, hw, &rate, NULL);
+    if (err < 0) goto fail;
+
+    alsa->period_size = (snd_pcm_uframes_t)backend->buffer_size;
+    err = snd_pcm_hw_params_set_period_size_near(alsa->pcm, hw, &alsa->period_size, NULL);
+    if (err < 0) goto fail;
+
+    unsigned int periods = ALSA_PERIODS;
+    err = snd_pcm_hw_params_set_periods_near(alsa->pcm, hw, &periods, NULL);
+    if (err < 0) goto fail;
+
+    err = snd_pcm_hw_params(alsa->pcm, hw);
+    if (err < 0) goto fail;
+
+    // Read back what the device settled on
+    snd_pcm_uframes_t buffer_frames;
+    snd_pcm_hw_params_get_period_size(hw, &alsa->period_size, NULL);
+    snd_pcm_hw_params_get_buffer_size(hw, &buffer_frames);
+
+    // Start once the whole buffer is primed; wake for every period
+    err = snd_pcm_sw_params_current(alsa->pcm, sw);
+    if (err < 0) goto fail;
+    err = snd_pcm_sw_params_set_start_threshold(alsa->pcm, sw,
+                                                (buffer_frames / alsa->period_size) * alsa->period_size);
+    if (err < 0) goto fail;
+    err = snd_pcm_sw_params_set_avail_min(alsa->pcm, sw, alsa->period_size);
+    if (err < 0) goto fail;
+    err = snd_pcm_sw_params(alsa->pcm, sw);
+    if (err < 0) goto fail;
+
+    backend->sample_rate = (float)rate;
+    backend->buffer_size = (int)alsa->period_size;
+    backend->periods = (int)(buffer_frames / alsa->period_size);
+    return true;
+
+fail:
+    fprintf(stderr, "Failed to configure ALSA device: %s\n", snd_strerror(err));
+    return false;
+}
+
+static bool alsa_open(AudioBackend* backend) {
+    AlsaBackend* alsa = (AlsaBackend*)calloc(1, sizeof(AlsaBackend));
+    if (!alsa) return false;
+
+    const char* device = getenv("PM_SYNTH_ALSA_DEVICE");
+    if (!device || !*device) device = ALSA_DEFAULT_DEVICE;
+
+    int err = snd_pcm_open(&alsa->pcm, device, SND_PCM_STREAM_PLAYBACK, 0);
+    if (err < 0) {
+        fprintf(stderr, "Failed to open ALSA device %s: %s\n", device, snd_strerror(err));
+        free(alsa);
+        return false;
+    }
+
+    if (!alsa_configure(backend, alsa)) {
+        snd_pcm_close(alsa->pcm);
+        free(alsa);
+        return false;
+    }
+
+    // Only a device that takes mono float can be rendered into directly
+    if (alsa->format != SND_PCM_FORMAT_FLOAT_LE || alsa->channels != 1) {
+        alsa->scratch = (float*)calloc(alsa->period_size, sizeof(float));
+        if (!alsa->scratch) {
+            snd_pcm_close(alsa->pcm);
+            free(alsa);
+            return false;
+        }
+    }
+
+    fprintf(stderr, "ALSA device %s opened: %.0f Hz, %s, %u channel(s), %d x %d frames%s\n",
+            device, backend->sample_rate, snd_pcm_format_name(alsa->format), alsa->channels,
+            backend->periods, backend->buffer_size, alsa->scratch ? "" : " (zero-copy)");
+
+    backend->impl = alsa;
+    return true;
+}
+
+static void alsa_close(AudioBackend* backend) {
+    AlsaBackend* alsa = (AlsaBackend*)backend->impl;
+    snd_pcm_close(alsa->pcm);
+    free(alsa->scratch);
+    free(alsa);
+}
+
+static bool alsa_start(AudioBackend* backend) {
+    AlsaBackend* alsa = (AlsaBackend*)backend->impl;
+
+    int err = snd_pcm_prepare(alsa->pcm);
+    if (err < 0) {
+        fprintf(stderr, "Failed to prepare ALSA device: %s\n", snd_strerror(err));
+        return false;
+    }
+
+    // Real-time scheduling needs a privilege (rtprio limit or CAP_SYS_NICE);
+    // without it the thread still runs, at normal priority
+    pthread_attr_t attr;
+    struct sched_param param;
+    pthread_attr_init(&attr);
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+    param.sched_priority = ALSA_RT_PRIORITY;
+    if (param.sched_priority > sched_get_priority_max(SCHED_FIFO)) {
+        param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+    }
+    pthread_attr_setschedparam(&attr, &param);
+
+    err = pthread_create(&alsa->audio_thread, &attr, alsa_thread_func, backend);
+    pthread_attr_destroy(&attr);
+    if (err == EPERM) {
+        fprintf(stderr, "No permission for SCHED_FIFO, ALSA thread runs at normal priority\n");
+        err = pthread_create(&alsa->audio_thread, NULL, alsa_thread_func, backend);
+    }
+    if (err != 0) {
+        fprintf(stderr, "Failed to create audio thread\n");
+        return false;
+    }
+
+    return true;
+}
+
+static void alsa_stop(AudioBackend* backend) {
+    AlsaBackend* alsa = (AlsaBackend*)backend->impl;
+
+    pthread_join(alsa->audio_thread, NULL);
+    snd_pcm_drop(alsa->pcm);
+}
+
+const AudioBackendOps audio_backend_alsa_ops = {
+    .name = "ALSA",
+    .open = alsa_open,
+    .close = alsa_close,
+    .start = alsa_start,
+    .stop = alsa_stop,
+};
@@ -0,0 +1,153 @@
+// audio_backend_jack.c
+// JACK backend implementation
+// Audio is rendered from JACK's process callback, on the server's real-time
+// thread, with whatever frame count the server asks for. Sample rate and
+// buffer size follow the server. MIDI arrives through a JACK MIDI port.
+
+#include "audio_backend_private.h"
+#include <jack/jack.h>
+#include <jack/midiport.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+typedef struct {
+    jack_client_t* client;
+    jack_port_t* output_port;
+    jack_port_t* midi_port;
+} JackBackend;
+
+static int jack_process(jack_nframes_t nframes, void* arg) {
+    AudioBackend* backend = (AudioBackend*)arg;
+    JackBackend* jack = (JackBackend*)backend->impl;
+    float* output = (float*)jack_port_get_buffer(jack->output_port, nframes);
+
+    if (!atomic_load_explicit(&backend->running, memory_order_relaxed)) {
+        memset(output, 0, nframes * sizeof(float));
+        return 0;
+    }
+
+    // Hand this cycle's MIDI over first so it can be scheduled in the block
+    if (backend->midi_callback) {
+        void* midi = jack_port_get_buffer(jack->midi_port, nframes);
+        jack_nframes_t count = jack_midi_get_event_count(midi);
+        for (jack_nframes_t i = 0; i < count; i++) {
+            jack_midi_event_t event;
+            if (jack_midi_event_get(&event, midi, i) == 0) {
+                backend->midi_callback(event.buffer, event.size, (int)event.time,
+                                       backend->user_data);
+            }
+        }
+    }
+
+    audio_backend_render(backend, output, (int)nframes);
+    return 0;
+}
+
+// Called from a non-real-time thread while no process callback is running
+static int jack_buffer_size_changed(jack_nframes_t nframes, void* arg) {
+    AudioBackend* backend = (AudioBackend*)arg;
+    backend->buffer_size = (int)nframes;
+    return 0;
+}
+
+static int jack_xrun(void* arg) {
+    AudioBackend* backend = (AudioBackend*)arg;
+    atomic_fetch_add_explicit(&backend->xruns, 1, memory_order_relaxed);
+    return 0;
+}
+
+static void jack_shutdown(void* arg) {
+    AudioBackend* backend = (AudioBackend*)arg;
+    backend->running = false;
+    fprintf(stderr, "JACK server shut down\n");
+}
+
+static bool jack_open(AudioBackend* backend) {
+    JackBackend* jack = (JackBackend*)calloc(1, sizeof(JackBackend));
+    if (!jack) return false;
+
+    jack_status_t status;
+    jack->client = jack_client_open("PM Synth GTK", JackNoStartServer, &status);
+    if (!jack->client) {
+        fprintf(stderr, "Failed to connect to JACK server (status 0x%x)\n", (unsigned)status);
+        free(jack);
+        return false;
+    }
+
+    jack->output_port = jack_port_register(jack->client, "out", JACK_DEFAULT_AUDIO_TYPE,
+                                           JackPortIsOutput | JackPortIsTerminal, 0);
+    jack->midi_port = jack_port_register(jack->client, "midi_in", JACK_DEFAULT_MIDI_TYPE,
+                                         JackPortIsInput | JackPortIsTerminal, 0);
+    if (!jack->output_port || !jack->midi_port) {
+        fprintf(stderr, "Failed to register JACK ports\n");
+        jack_client_close(jack->client);
+        free(jack);
+        return false;
+    }
+
+    jack_set_process_callback(jack->client, jack_process, backend);
+    jack_set_buffer_size_callback(jack->client, jack_buffer_size_changed, backend);
+    jack_set_xrun_callback(jack->client, jack_xrun, backend);
+    jack_on_shutdown(jack->client, jack_shutdown, backend);
+
+    // The server decides; the requested values are only a hint
+    backend->sample_rate = (float)jack_get_sample_rate(jack->client);
+    backend->buffer_size = (int)jack_get_buffer_size(jack->client);
+
+    fprintf(stderr, "JACK client \"%s\" created: %.0f Hz, %d frames%s\n",
+            jack_get_client_name(jack->client), backend->sample_rate, backend->buffer_size,
+            jack_is_realtime(jack->client) ? "" : " (server is not running real-time)");
+
+    backend->impl = jack;
+    return true;
+}
+
+static void jack_close(AudioBackend* backend) {
+    JackBackend* jack = (JackBackend*)backend->impl;
+    jack_client_close(jack->client);
+    free(jack);
+}
+
+// Connect the output to every physical playback port; the mono signal
+// goes to both sides of a stereo device. Missing ports are not an error,
+// e.g. with the dummy driver nothing needs connecting.
+static void jack_connect_playback(JackBackend* jack) {
+    const char** ports = jack_get_ports(jack->client, NULL, JACK_DEFAULT_AUDIO_TYPE,
+                                        JackPortIsPhysical | JackPortIsInput);
+    if (!ports) return;
+
+    for (int i = 0; ports[i]; i++) {
+        if (jack_connect(jack->client, jack_port_name(jack->output_port), ports[i]) != 0) {
+            fprintf(stderr, "Could not connect to %s\n", ports[i]);
+        }
+    }
+    jack_free(ports);
+}
+
+static bool jack_start(AudioBackend* backend) {
+    JackBackend* jack = (JackBackend*)backend->impl;
+
+    if (jack_activate(jack->client) != 0) {
+        fprintf(stderr, "Failed to activate JACK client\n");
+        return false;
+    }
+
+    jack_connect_playback(jack);
+    return true;
+}
+
+static void jack_stop(AudioBackend* backend) {
+    JackBackend* jack = (JackBackend*)backend->impl;
+
+    // Returns once the process callback can no longer run
+    jack_deactivate(jack->client);
+}
+
+const AudioBackendOps audio_backend_jack_ops = {
+    .name = "JACK",
+    .open = jack_open,
+    .close = jack_close,
+    .start = jack_start,
+    .stop = jack_stop,
+};
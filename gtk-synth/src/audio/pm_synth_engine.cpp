@@ -0,0 +1,178 @@
+// pm_synth_engine.cpp
+// C API of pm_synth.h over the shared C++ engine in lv2/pm-synth/src
+// The DSP lives only in the C++ headers; this file maps the 0-100 control
+// ranges onto the engine's normalized setters.
+
+extern "C" {
+#include "pm_synth.h"
+}
+
+#include "DenormalGuard.hpp"
+#include "PMSynthEngine.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+struct PMSynthEngine {
+    explicit PMSynthEngine(float sample_rate) : engine(sample_rate) {}
+
+    flues::pm::PMSynthEngine engine;
+};
+
+namespace {
+
+// Interface type names
+const char* const INTERFACE_NAMES[] = {
+    "Pluck", "Hit", "Reed", "Flute", "Brass", "Bow", "Bell", "Drum",
+    "Crystal", "Vapor", "Quantum", "Plasma"
+};
+
+float normalized(float value) {
+    return value / 100.0f;
+}
+
+} // namespace
+
+extern "C" {
+
+PMSynthEngine* pm_synth_create(float sample_rate) {
+    PMSynthEngine* synth;
+    try {
+        synth = new PMSynthEngine(sample_rate);
+    } catch (...) {
+        return nullptr;
+    }
+
+    // Set default parameters (from constants.js)
+    pm_synth_set_dc_level(synth, 0.0f);      // DC off by default
+    pm_synth_set_noise_level(synth, 10.0f);  // 10% noise
+    pm_synth_set_tone_level(synth, 0.0f);    // Tone off
+    pm_synth_set_attack(synth, 10.0f);       // Fast attack
+    pm_synth_set_release(synth, 50.0f);      // Medium release
+    pm_synth_set_interface_type(synth, INTERFACE_REED);
+    pm_synth_set_interface_intensity(synth, 50.0f);
+    pm_synth_set_delay1_feedback(synth, 0.0f);  // Start with no feedback
+    pm_synth_set_delay2_feedback(synth, 0.0f);  // Start with no feedback
+    pm_synth_set_filter_feedback(synth, 0.0f);  // No filter feedback
+    pm_synth_set_filter_frequency(synth, 70.0f);
+    pm_synth_set_filter_q(synth, 20.0f);
+    pm_synth_set_filter_shape(synth, 0.0f);
+    pm_synth_set_lfo_frequency(synth, 30.0f);
+    pm_synth_set_modulation_depth(synth, 50.0f); // Center = no modulation
+    pm_synth_set_reverb_size(synth, 50.0f);
+    pm_synth_set_reverb_level(synth, 30.0f);
+
+    return synth;
+}
+
+void pm_synth_destroy(PMSynthEngine* synth) {
+    delete synth;
+}
+
+void pm_synth_process(PMSynthEngine* synth, float* output, int num_samples) {
+    if (num_samples <= 0) return;
+
+    const flues::pm::DenormalGuard denormal_guard;
+    synth->engine.processBlock(output, static_cast<uint32_t>(num_samples));
+}
+
+void pm_synth_note_on(PMSynthEngine* synth, float frequency) {
+    synth->engine.noteOn(frequency);
+}
+
+void pm_synth_note_off(PMSynthEngine* synth) {
+    synth->engine.noteOff();
+}
+
+// Parameter setters (0-100 range, normalized here)
+void pm_synth_set_dc_level(PMSynthEngine* synth, float value) {
+    synth->engine.setDCLevel(normalized(value));
+}
+
+void pm_synth_set_noise_level(PMSynthEngine* synth, float value) {
+    synth->engine.setNoiseLevel(normalized(value));
+}
+
+void pm_synth_set_tone_level(PMSynthEngine* synth, float value) {
+    synth->engine.setToneLevel(normalized(value));
+}
+
+void pm_synth_set_attack(PMSynthEngine* synth, float value) {
+    synth->engine.setAttack(normalized(value));
+}
+
+void pm_synth_set_release(PMSynthEngine* synth, float value) {
+    synth->engine.setRelease(normalized(value));
+}
+
+void pm_synth_set_interface_type(PMSynthEngine* synth, InterfaceType type) {
+    synth->engine.setInterfaceType(static_cast<float>(type));
+}
+
+void pm_synth_set_interface_intensity(PMSynthEngine* synth, float value) {
+    synth->engine.setInterfaceIntensity(normalized(value));
+}
+
+void pm_synth_set_tuning(PMSynthEngine* synth, float value) {
+    synth->engine.setTuning(normalized(value));
+}
+
+void pm_synth_set_ratio(PMSynthEngine* synth, float value) {
+    synth->engine.setRatio(normalized(value));
+}
+
+// Feedback gains scale to 0-0.99 inside the engine
+void pm_synth_set_delay1_feedback(PMSynthEngine* synth, float value) {
+    synth->engine.setDelay1Feedback(normalized(value));
+}
+
+void pm_synth_set_delay2_feedback(PMSynthEngine* synth, float value) {
+    synth->engine.setDelay2Feedback(normalized(value));
+}
+
+void pm_synth_set_filter_feedback(PMSynthEngine* synth, float value) {
+    synth->engine.setFilterFeedback(normalized(value));
+}
+
+void pm_synth_set_filter_frequency(PMSynthEngine* synth, float value) {
+    synth->engine.setFilterFrequency(normalized(value));
+}
+
+void pm_synth_set_filter_q(PMSynthEngine* synth, float value) {
+    synth->engine.setFilterQ(normalized(value));
+}
+
+void pm_synth_set_filter_shape(PMSynthEngine* synth, float value) {
+    synth->engine.setFilterShape(normalized(value));
+}
+
+void pm_synth_set_lfo_frequency(PMSynthEngine* synth, float value) {
+    synth->engine.setLFOFrequency(normalized(value));
+}
+
+// 0 = full AM, 50 = none, 100 = full FM
+void pm_synth_set_modulation_depth(PMSynthEngine* synth, float value) {
+    synth->engine.setModulationTypeLevel(normalized(value));
+}
+
+void pm_synth_set_reverb_size(PMSynthEngine* synth, float value) {
+    synth->engine.setReverbSize(normalized(value));
+}
+
+void pm_synth_set_reverb_level(PMSynthEngine* synth, float value) {
+    synth->engine.setReverbLevel(normalized(value));
+}
+
+// Utility functions
+float pm_synth_midi_to_frequency(int midi_note) {
+    return 440.0f * std::pow(2.0f, (midi_note - 69) / 12.0f);
+}
+
+const char* pm_synth_interface_name(InterfaceType type) {
+    if (type >= 0 && type <= 11) {
+        return INTERFACE_NAMES[type];
+    }
+    return "Unknown";
+}
+
+} // extern "C"
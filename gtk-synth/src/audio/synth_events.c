@@ -0,0 +1,240 @@
+// synth_events.c
+// Lock-free UI -> audio thread event queue
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "synth_events.h"
+#include <time.h>
+
+#define SYNTH_EVENT_QUEUE_MASK (SYNTH_EVENT_QUEUE_CAPACITY - 1)
+
+_Static_assert((SYNTH_EVENT_QUEUE_CAPACITY & SYNTH_EVENT_QUEUE_MASK) == 0,
+               "SYNTH_EVENT_QUEUE_CAPACITY must be a power of two");
+
+typedef void (*SynthParamSetter)(PMSynthEngine* synth, float value);
+
+// SYNTH_PARAM_INTERFACE_TYPE takes an InterfaceType and is applied separately
+static const SynthParamSetter param_setters[SYNTH_PARAM_COUNT] = {
+    [SYNTH_PARAM_DC_LEVEL] = pm_synth_set_dc_level,
+    [SYNTH_PARAM_NOISE_LEVEL] = pm_synth_set_noise_level,
+    [SYNTH_PARAM_TONE_LEVEL] = pm_synth_set_tone_level,
+    [SYNTH_PARAM_ATTACK] = pm_synth_set_attack,
+    [SYNTH_PARAM_RELEASE] = pm_synth_set_release,
+    [SYNTH_PARAM_INTERFACE_INTENSITY] = pm_synth_set_interface_intensity,
+    [SYNTH_PARAM_TUNING] = pm_synth_set_tuning,
+    [SYNTH_PARAM_RATIO] = pm_synth_set_ratio,
+    [SYNTH_PARAM_DELAY1_FEEDBACK] = pm_synth_set_delay1_feedback,
+    [SYNTH_PARAM_DELAY2_FEEDBACK] = pm_synth_set_delay2_feedback,
+    [SYNTH_PARAM_FILTER_FEEDBACK] = pm_synth_set_filter_feedback,
+    [SYNTH_PARAM_FILTER_FREQUENCY] = pm_synth_set_filter_frequency,
+    [SYNTH_PARAM_FILTER_Q] = pm_synth_set_filter_q,
+    [SYNTH_PARAM_FILTER_SHAPE] = pm_synth_set_filter_shape,
+    [SYNTH_PARAM_LFO_FREQUENCY] = pm_synth_set_lfo_frequency,
+    [SYNTH_PARAM_MODULATION_DEPTH] = pm_synth_set_modulation_depth,
+    [SYNTH_PARAM_REVERB_SIZE] = pm_synth_set_reverb_size,
+    [SYNTH_PARAM_REVERB_LEVEL] = pm_synth_set_reverb_level,
+};
+
+static int64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void synth_event_queue_init(SynthEventQueue* queue, float sample_rate, int block_size) {
+    atomic_init(&queue->write_index, 0);
+    atomic_init(&queue->read_index, 0);
+    atomic_init(&queue->clock_sequence, 0);
+    atomic_init(&queue->block_frame, 0);
+    atomic_init(&queue->block_time_ns, 0);
+    atomic_init(&queue->block_length, block_size);
+    queue->last_frame = 0;
+    queue->sample_rate = sample_rate;
+    queue->stream_frame = 0;
+    queue->sounding_note = -1;
+    queue->midi_count = 0;
+}
+
+// ============================================================================
+// Producer
+// ============================================================================
+
+static uint64_t stamp_frame(SynthEventQueue* queue) {
+    unsigned sequence;
+    uint64_t frame;
+    int64_t time_ns;
+    int length;
+
+    // Retry until the audio thread was not mid-update
+    for (;;) {
+        sequence = atomic_load_explicit(&queue->clock_sequence, memory_order_acquire);
+        frame = atomic_load_explicit(&queue->block_frame, memory_order_relaxed);
+        time_ns = atomic_load_explicit(&queue->block_time_ns, memory_order_relaxed);
+        length = atomic_load_explicit(&queue->block_length, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (!(sequence & 1u) &&
+            sequence == atomic_load_explicit(&queue->clock_sequence, memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    // Clamped to one block, so a stalled or not yet started audio thread
+    // cannot push events arbitrarily far into the future
+    double elapsed = (double)(monotonic_ns() - time_ns) * 1e-9 * queue->sample_rate;
+    if (elapsed < 0.0) elapsed = 0.0;
+    if (elapsed > length) elapsed = length;
+
+    uint64_t stamp = frame + (uint64_t)length + (uint64_t)elapsed;
+
+    // Keep the queue in time order
+    if (stamp < queue->last_frame) stamp = queue->last_frame;
+    queue->last_frame = stamp;
+    return stamp;
+}
+
+static bool push_event(SynthEventQueue* queue, SynthEventType type, int32_t id, float value) {
+    size_t write = atomic_load_explicit(&queue->write_index, memory_order_relaxed);
+    size_t read = atomic_load_explicit(&queue->read_index, memory_order_acquire);
+    if (write - read == SYNTH_EVENT_QUEUE_CAPACITY) {
+        return false;
+    }
+
+    SynthEvent* event = &queue->events[write & SYNTH_EVENT_QUEUE_MASK];
+    event->frame = stamp_frame(queue);
+    event->type = type;
+    event->id = id;
+    event->value = value;
+
+    atomic_store_explicit(&queue->write_index, write + 1, memory_order_release);
+    return true;
+}
+
+bool synth_event_queue_push_param(SynthEventQueue* queue, SynthParam param, float value) {
+    if ((int)param < 0 || (int)param >= SYNTH_PARAM_COUNT) return false;
+    return push_event(queue, SYNTH_EVENT_PARAM, (int32_t)param, value);
+}
+
+bool synth_event_queue_push_note_on(SynthEventQueue* queue, int midi_note) {
+    return push_event(queue, SYNTH_EVENT_NOTE_ON, midi_note, 0.0f);
+}
+
+bool synth_event_queue_push_note_off(SynthEventQueue* queue, int midi_note) {
+    return push_event(queue, SYNTH_EVENT_NOTE_OFF, midi_note, 0.0f);
+}
+
+// ============================================================================
+// Consumer
+// ============================================================================
+
+static void publish_clock(SynthEventQueue* queue, uint64_t frame, int length) {
+    unsigned sequence = atomic_load_explicit(&queue->clock_sequence, memory_order_relaxed);
+    atomic_store_explicit(&queue->clock_sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&queue->block_frame, frame, memory_order_relaxed);
+    atomic_store_explicit(&queue->block_time_ns, monotonic_ns(), memory_order_relaxed);
+    atomic_store_explicit(&queue->block_length, length, memory_order_relaxed);
+    atomic_store_explicit(&queue->clock_sequence, sequence + 2, memory_order_release);
+}
+
+static void apply_event(SynthEventQueue* queue, PMSynthEngine* synth, const SynthEvent* event) {
+    switch (event->type) {
+        case SYNTH_EVENT_PARAM:
+            if (event->id == SYNTH_PARAM_INTERFACE_TYPE) {
+                pm_synth_set_interface_type(synth, (InterfaceType)event->value);
+            } else {
+                param_setters[event->id](synth, event->value);
+            }
+            break;
+        case SYNTH_EVENT_NOTE_ON:
+            pm_synth_note_on(synth, pm_synth_midi_to_frequency(event->id));
+            queue->sounding_note = event->id;
+            break;
+        case SYNTH_EVENT_NOTE_OFF:
+            // The engine is monophonic: only releasing the latest note ends it
+            if (event->id == queue->sounding_note) {
+                pm_synth_note_off(synth);
+                queue->sounding_note = -1;
+            }
+            break;
+    }
+}
+
+void synth_event_queue_add_midi(SynthEventQueue* queue, const uint8_t* data,
+                                size_t size, int frame) {
+    if (size < 3 || queue->midi_count == SYNTH_MIDI_BLOCK_CAPACITY) return;
+
+    uint8_t status = data[0] & 0xF0;
+    SynthEventType type;
+    if (status == 0x90 && data[2] > 0) {
+        type = SYNTH_EVENT_NOTE_ON;
+    } else if (status == 0x80 || status == 0x90) {
+        type = SYNTH_EVENT_NOTE_OFF;
+    } else {
+        return;
+    }
+
+    SynthEvent* event = &queue->midi_events[queue->midi_count++];
+    event->frame = queue->stream_frame + (uint64_t)(frame > 0 ? frame : 0);
+    event->type = type;
+    event->id = data[1] & 0x7F;
+    event->value = 0.0f;
+}
+
+void synth_event_queue_process(SynthEventQueue* queue, PMSynthEngine* synth,
+                               float* output, int num_samples) {
+    const uint64_t start = queue->stream_frame;
+    const uint64_t end = start + (uint64_t)num_samples;
+    publish_clock(queue, start, num_samples);
+
+    size_t read = atomic_load_explicit(&queue->read_index, memory_order_relaxed);
+    const size_t write = atomic_load_explicit(&queue->write_index, memory_order_acquire);
+    int midi = 0;
+    int rendered = 0;
+
+    // Merge the UI queue with this block's MIDI, both in time order
+    for (;;) {
+        const SynthEvent* event = NULL;
+        if (read != write && queue->events[read & SYNTH_EVENT_QUEUE_MASK].frame < end) {
+            event = &queue->events[read & SYNTH_EVENT_QUEUE_MASK];
+        }
+        if (midi < queue->midi_count && queue->midi_events[midi].frame < end &&
+            (!event || queue->midi_events[midi].frame < event->frame)) {
+            event = &queue->midi_events[midi++];
+        } else if (event) {
+            read++;
+        } else {
+            break;
+        }
+
+        // Render up to the event, then apply it
+        int offset = event->frame > start ? (int)(event->frame - start) : 0;
+        if (offset > rendered) {
+            pm_synth_process(synth, output + rendered, offset - rendered);
+            rendered = offset;
+        }
+        apply_event(queue, synth, event);
+    }
+    atomic_store_explicit(&queue->read_index, read, memory_order_release);
+
+    if (rendered < num_samples) {
+        pm_synth_process(synth, output + rendered, num_samples - rendered);
+    }
+
+    // MIDI stamped past the end of the block lands on the block boundary
+    // rather than being lost
+    while (midi < queue->midi_count) {
+        apply_event(queue, synth, &queue->midi_events[midi++]);
+    }
+    queue->midi_count = 0;
+    queue->stream_frame = end;
+}
+
+void synth_event_queue_flush(SynthEventQueue* queue, PMSynthEngine* synth) {
+    size_t read = atomic_load_explicit(&queue->read_index, memory_order_relaxed);
+    const size_t write = atomic_load_explicit(&queue->write_index, memory_order_acquire);
+    while (read != write) {
+        apply_event(queue, synth, &queue->events[read & SYNTH_EVENT_QUEUE_MASK]);
+        read++;
+    }
+    atomic_store_explicit(&queue->read_index, read, memory_order_release);
+}
@@ -4,14 +4,17 @@
 
 #include "pm_synth.h"
 #include "audio_backend.h"
+#include "synth_events.h"
 #include <gtk/gtk.h>
 #include <stdio.h>
+#include <string.h>
 
 typedef struct {
     GtkApplication *app;
     GtkWidget *window;
     PMSynthEngine *synth;
     AudioBackend *audio;
+    SynthEventQueue events;     // GTK thread -> audio thread
 
     // Control widgets
     GtkWidget *interface_selector;
@@ -34,113 +37,129 @@ typedef struct {
     GtkScale *reverb_size_scale;
     GtkScale *reverb_level_scale;
 
-    bool audio_running;
     int current_note;
 } SynthWindow;
 
 // Audio callback
 static void audio_process_callback(float* output, int num_samples, void* user_data) {
     SynthWindow* win = (SynthWindow*)user_data;
-    pm_synth_process(win->synth, output, num_samples);
+    synth_event_queue_process(&win->events, win->synth, output, num_samples);
+}
+
+// MIDI input, on the audio thread ahead of the block it belongs to
+static void audio_midi_callback(const uint8_t* data, size_t size, int frame, void* user_data) {
+    SynthWindow* win = (SynthWindow*)user_data;
+    synth_event_queue_add_midi(&win->events, data, size, frame);
+}
+
+// Hands an event to the audio thread. The engine is only touched directly
+// when no audio thread is running to race with.
+static void send_param(SynthWindow *win, SynthParam param, double value) {
+    if (!synth_event_queue_push_param(&win->events, param, (float)value)) {
+        fprintf(stderr, "Event queue full, dropped parameter change\n");
+    }
+    if (!audio_backend_is_running(win->audio)) {
+        synth_event_queue_flush(&win->events, win->synth);
+    }
 }
 
 // Control callbacks
 static void on_interface_changed(GtkDropDown *dropdown, GParamSpec *pspec, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
     guint selected = gtk_drop_down_get_selected(dropdown);
-    pm_synth_set_interface_type(win->synth, (InterfaceType)selected);
+    send_param(win, SYNTH_PARAM_INTERFACE_TYPE, selected);
     printf("Interface changed to: %s\n", pm_synth_interface_name((InterfaceType)selected));
     (void)pspec; // Unused
 }
 
 static void on_dc_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_dc_level(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_DC_LEVEL, gtk_range_get_value(range));
 }
 
 static void on_noise_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_noise_level(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_NOISE_LEVEL, gtk_range_get_value(range));
 }
 
 static void on_attack_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_attack(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_ATTACK, gtk_range_get_value(range));
 }
 
 static void on_release_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_release(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_RELEASE, gtk_range_get_value(range));
 }
 
 static void on_intensity_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_interface_intensity(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_INTERFACE_INTENSITY, gtk_range_get_value(range));
 }
 
 static void on_delay1_fb_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_delay1_feedback(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_DELAY1_FEEDBACK, gtk_range_get_value(range));
 }
 
 static void on_delay2_fb_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_delay2_feedback(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_DELAY2_FEEDBACK, gtk_range_get_value(range));
 }
 
 static void on_tone_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_tone_level(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_TONE_LEVEL, gtk_range_get_value(range));
 }
 
 static void on_tuning_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_tuning(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_TUNING, gtk_range_get_value(range));
 }
 
 static void on_ratio_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_ratio(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_RATIO, gtk_range_get_value(range));
 }
 
 static void on_filter_fb_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_filter_feedback(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_FILTER_FEEDBACK, gtk_range_get_value(range));
 }
 
 static void on_filter_freq_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_filter_frequency(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_FILTER_FREQUENCY, gtk_range_get_value(range));
 }
 
 static void on_filter_q_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_filter_q(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_FILTER_Q, gtk_range_get_value(range));
 }
 
 static void on_filter_shape_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_filter_shape(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_FILTER_SHAPE, gtk_range_get_value(range));
 }
 
 static void on_lfo_freq_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_lfo_frequency(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_LFO_FREQUENCY, gtk_range_get_value(range));
 }
 
 static void on_mod_depth_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_modulation_depth(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_MODULATION_DEPTH, gtk_range_get_value(range));
 }
 
 static void on_reverb_size_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_reverb_size(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_REVERB_SIZE, gtk_range_get_value(range));
 }
 
 static void on_reverb_level_changed(GtkRange *range, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_set_reverb_level(win->synth, gtk_range_get_value(range));
+    send_param(win, SYNTH_PARAM_REVERB_LEVEL, gtk_range_get_value(range));
 }
 
 // Keyboard event handler
@@ -149,7 +168,7 @@ static gboolean on_key_pressed(GtkEventControllerKey *controller,
                                GdkModifierType state, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
 
-    if (!win->audio_running) return FALSE;
+    if (!audio_backend_is_running(win->audio)) return FALSE;
 
     // Simple keyboard mapping (A-K = C4-C5)
     int note = -1;
@@ -171,8 +190,7 @@ static gboolean on_key_pressed(GtkEventControllerKey *controller,
 
     if (note >= 0) {
         win->current_note = note;
-        float freq = pm_synth_midi_to_frequency(note);
-        pm_synth_note_on(win->synth, freq);
+        synth_event_queue_push_note_on(&win->events, note);
         return TRUE;
     }
 
@@ -183,7 +201,9 @@ static gboolean on_key_released(GtkEventControllerKey *controller,
                                 guint keyval, guint keycode,
                                 GdkModifierType state, gpointer user_data) {
     SynthWindow *win = (SynthWindow*)user_data;
-    pm_synth_note_off(win->synth);
+    if (audio_backend_is_running(win->audio)) {
+        synth_event_queue_push_note_off(&win->events, win->current_note);
+    }
     return TRUE;
 }
 
@@ -374,7 +394,6 @@ static void activate(GtkApplication *app, gpointer user_data) {
 
     // Start audio automatically
     if (audio_backend_start(win->audio)) {
-        win->audio_running = true;
         printf("Audio started successfully\n");
     } else {
         fprintf(stderr, "Failed to start audio\n");
@@ -383,25 +402,38 @@ static void activate(GtkApplication *app, gpointer user_data) {
     gtk_window_present(GTK_WINDOW(win->window));
 }
 
+// Audio backend from PM_SYNTH_BACKEND ("pulse", "jack" or "alsa"), PulseAudio by default
+static AudioBackendType backend_from_environment(void) {
+    const char *name = g_getenv("PM_SYNTH_BACKEND");
+    if (name && g_ascii_strcasecmp(name, "jack") == 0) return AUDIO_BACKEND_JACK;
+    if (name && g_ascii_strcasecmp(name, "alsa") == 0) return AUDIO_BACKEND_ALSA;
+    return AUDIO_BACKEND_PULSEAUDIO;
+}
+
 int main(int argc, char **argv) {
     SynthWindow win = {0};
 
-    // Create synthesizer engine
-    win.synth = pm_synth_create(DEFAULT_SAMPLE_RATE);
-    if (!win.synth) {
-        fprintf(stderr, "Failed to create synth engine\n");
-        return 1;
-    }
-
-    // Create audio backend (PulseAudio)
-    win.audio = audio_backend_create(AUDIO_BACKEND_PULSEAUDIO,
+    // Create audio backend first: a JACK server dictates the sample rate
+    win.audio = audio_backend_create(backend_from_environment(),
                                      DEFAULT_SAMPLE_RATE, DEFAULT_BUFFER_SIZE,
                                      audio_process_callback, &win);
     if (!win.audio) {
         fprintf(stderr, "Failed to create audio backend\n");
-        pm_synth_destroy(win.synth);
         return 1;
     }
+    audio_backend_set_midi_callback(win.audio, audio_midi_callback);
+
+    float sample_rate = audio_backend_get_sample_rate(win.audio);
+
+    // Create synthesizer engine
+    win.synth = pm_synth_create(sample_rate);
+    if (!win.synth) {
+        fprintf(stderr, "Failed to create synth engine\n");
+        audio_backend_destroy(win.audio);
+        return 1;
+    }
+
+    synth_event_queue_init(&win.events, sample_rate, audio_backend_get_buffer_size(win.audio));
 
     // Create GTK application
     win.app = gtk_application_new("org.flues.pmsynth", G_APPLICATION_DEFAULT_FLAGS);
@@ -410,6 +442,20 @@ int main(int argc, char **argv) {
     int status = g_application_run(G_APPLICATION(win.app), argc, argv);
 
     // Cleanup
+    audio_backend_stop(win.audio);
+
+    AudioBackendStats stats;
+    if (audio_backend_get_stats(win.audio, &stats)) {
+        printf("%s: %llu frames rendered, %llu xruns (%llu underruns), %d-frame periods\n",
+               audio_backend_get_name(win.audio), (unsigned long long)stats.frames,
+               (unsigned long long)stats.xruns, (unsigned long long)stats.underruns,
+               stats.period_size);
+        if (stats.error != 0) {
+            fprintf(stderr, "%s stream stopped: %s\n",
+                    audio_backend_get_name(win.audio), strerror(-stats.error));
+        }
+    }
+
     audio_backend_destroy(win.audio);
     pm_synth_destroy(win.synth);
     g_object_unref(win.app);
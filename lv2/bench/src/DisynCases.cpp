@@ -0,0 +1,44 @@
+#include "Harness.hpp"
+
+#include "../../disyn/src/DisynEngine.hpp"
+
+namespace flues::bench {
+
+namespace {
+
+using flues::disyn::DisynEngine;
+
+struct DisynAdapter {
+    static std::unique_ptr<DisynEngine> create(const RunConfig& config) {
+        return std::make_unique<DisynEngine>(config.sampleRate);
+    }
+
+    static int voices(const RunConfig&) { return 1; }
+
+    static void notesOn(DisynEngine& engine, int rootNote, int) {
+        engine.noteOn(midiToFrequency(rootNote), 0.8f);
+    }
+
+    static void notesOff(DisynEngine& engine, int, int) {
+        engine.noteOff();
+    }
+
+    static void sweep(DisynEngine& engine, float amount) {
+        engine.setParam1(amount);
+        engine.setParam2(1.0f - amount);
+    }
+};
+
+} // namespace
+
+void addDisynCases(CaseList& cases) {
+    for (int algorithm = 0; algorithm < 7; ++algorithm) {
+        cases.push_back({"disyn", kAlgorithmNames[algorithm], [algorithm](const RunConfig& config) {
+            return runScript<DisynAdapter>(config, [algorithm](DisynEngine& engine) {
+                engine.setAlgorithm(algorithm);
+            });
+        }});
+    }
+}
+
+} // namespace flues::bench
@@ -0,0 +1,50 @@
+#include "Harness.hpp"
+
+#include "../../disyn-poly/src/DisynPolyEngine.hpp"
+
+namespace flues::bench {
+
+namespace {
+
+using flues::disyn_poly::DisynPolyEngine;
+
+struct DisynPolyAdapter {
+    static std::unique_ptr<DisynPolyEngine> create(const RunConfig& config) {
+        return std::make_unique<DisynPolyEngine>(config.sampleRate);
+    }
+
+    static int voices(const RunConfig& config) {
+        return std::clamp(config.voices, 1, static_cast<int>(DisynPolyEngine::kMaxVoices));
+    }
+
+    static void notesOn(DisynPolyEngine& engine, int rootNote, int voices) {
+        for (int i = 0; i < voices; ++i) {
+            engine.noteOn(chordNote(rootNote, i), midiToFrequency(chordNote(rootNote, i)), 0.8f);
+        }
+    }
+
+    static void notesOff(DisynPolyEngine& engine, int rootNote, int voices) {
+        for (int i = 0; i < voices; ++i) {
+            engine.noteOff(chordNote(rootNote, i));
+        }
+    }
+
+    static void sweep(DisynPolyEngine& engine, float amount) {
+        engine.setParam1(amount);
+        engine.setParam2(1.0f - amount);
+    }
+};
+
+} // namespace
+
+void addDisynPolyCases(CaseList& cases) {
+    for (int algorithm = 0; algorithm < 7; ++algorithm) {
+        cases.push_back({"disyn-poly", kAlgorithmNames[algorithm], [algorithm](const RunConfig& config) {
+            return runScript<DisynPolyAdapter>(config, [algorithm](DisynPolyEngine& engine) {
+                engine.setAlgorithm(algorithm);
+            });
+        }});
+    }
+}
+
+} // namespace flues::bench
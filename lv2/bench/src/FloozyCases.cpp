@@ -0,0 +1,56 @@
+#include "Harness.hpp"
+
+#include "../../floozy/src/FloozyEngine.hpp"
+
+namespace flues::bench {
+
+namespace {
+
+using flues::floozy::FloozyEngine;
+
+struct FloozyAdapter {
+    static std::unique_ptr<FloozyEngine> create(const RunConfig& config) {
+        auto engine = std::make_unique<FloozyEngine>(config.sampleRate);
+        engine->seed(config.seed);
+        return engine;
+    }
+
+    static int voices(const RunConfig&) { return 1; }
+
+    static void notesOn(FloozyEngine& engine, int rootNote, int) {
+        engine.noteOn(midiToFrequency(rootNote));
+    }
+
+    static void notesOff(FloozyEngine& engine, int, int) {
+        engine.noteOff();
+    }
+
+    static void sweep(FloozyEngine& engine, float amount) {
+        engine.setFilterFrequency(amount);
+        engine.setInterfaceIntensity(0.25f + 0.5f * amount);
+    }
+};
+
+} // namespace
+
+// Interface types are run with the default source algorithm and the
+// source algorithms with the default interface, rather than the full
+// 12 x 7 product.
+void addFloozyCases(CaseList& cases) {
+    for (int type = 0; type < 12; ++type) {
+        cases.push_back({"floozy", kInterfaceNames[type], [type](const RunConfig& config) {
+            return runScript<FloozyAdapter>(config, [type](FloozyEngine& engine) {
+                engine.setInterfaceType(static_cast<float>(type));
+            });
+        }});
+    }
+    for (int algorithm = 0; algorithm < 7; ++algorithm) {
+        cases.push_back({"floozy", kAlgorithmNames[algorithm], [algorithm](const RunConfig& config) {
+            return runScript<FloozyAdapter>(config, [algorithm](FloozyEngine& engine) {
+                engine.setAlgorithm(static_cast<float>(algorithm));
+            });
+        }});
+    }
+}
+
+} // namespace flues::bench
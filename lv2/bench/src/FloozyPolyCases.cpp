@@ -0,0 +1,61 @@
+#include "Harness.hpp"
+
+#include "../../floozy-poly/src/FloozyEngine.hpp"
+
+namespace flues::bench {
+
+namespace {
+
+using flues::floozy_poly::FloozyPolyEngine;
+
+struct FloozyPolyAdapter {
+    static std::unique_ptr<FloozyPolyEngine> create(const RunConfig& config) {
+        auto engine = std::make_unique<FloozyPolyEngine>(config.sampleRate);
+        engine->seed(config.seed);
+        engine->reserveRenderThreads(config.threads);
+        engine->setRenderThreads(static_cast<float>(config.threads));
+        return engine;
+    }
+
+    static int voices(const RunConfig& config) {
+        return std::clamp(config.voices, 1, static_cast<int>(FloozyPolyEngine::kMaxVoices));
+    }
+
+    static void notesOn(FloozyPolyEngine& engine, int rootNote, int voices) {
+        for (int i = 0; i < voices; ++i) {
+            engine.noteOn(chordNote(rootNote, i), midiToFrequency(chordNote(rootNote, i)));
+        }
+    }
+
+    static void notesOff(FloozyPolyEngine& engine, int rootNote, int voices) {
+        for (int i = 0; i < voices; ++i) {
+            engine.noteOff(chordNote(rootNote, i));
+        }
+    }
+
+    static void sweep(FloozyPolyEngine& engine, float amount) {
+        engine.setFilterFrequency(amount);
+        engine.setInterfaceIntensity(0.25f + 0.5f * amount);
+    }
+};
+
+} // namespace
+
+void addFloozyPolyCases(CaseList& cases) {
+    for (int type = 0; type < 12; ++type) {
+        cases.push_back({"floozy-poly", kInterfaceNames[type], [type](const RunConfig& config) {
+            return runScript<FloozyPolyAdapter>(config, [type](FloozyPolyEngine& engine) {
+                engine.setInterfaceType(static_cast<float>(type));
+            });
+        }});
+    }
+    for (int algorithm = 0; algorithm < 7; ++algorithm) {
+        cases.push_back({"floozy-poly", kAlgorithmNames[algorithm], [algorithm](const RunConfig& config) {
+            return runScript<FloozyPolyAdapter>(config, [algorithm](FloozyPolyEngine& engine) {
+                engine.setAlgorithm(static_cast<float>(algorithm));
+            });
+        }});
+    }
+}
+
+} // namespace flues::bench
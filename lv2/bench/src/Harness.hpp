@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../../pm-synth/src/DenormalGuard.hpp"
+#include "../../pm-synth/src/Profiler.hpp"
+
+namespace flues::bench {
+
+// One point of the rate x block-size grid.
+struct RunConfig {
+    float sampleRate = 48000.0f;
+    uint32_t blockSize = 64;
+    double seconds = 1.0;
+    int voices = 8;
+    // Render threads, for engines that can spread voices over several.
+    uint32_t threads = 1;
+    uint32_t seed = 1;
+    // Fraction of the run after which every note is released.
+    double releaseAt = 0.6;
+    // Render under a DenormalGuard, as the plugins' run() does.
+    bool flushDenormals = true;
+};
+
+struct RunResult {
+    uint64_t frames = 0;
+    uint64_t blocks = 0;
+    int voices = 1;
+    double totalSeconds = 0.0;
+    double nsPerSample = 0.0;
+    double realtimeFactor = 0.0;
+    double blockP50Us = 0.0;
+    double blockP99Us = 0.0;
+    double blockMaxUs = 0.0;
+    // Block-time percentiles while notes are held and over the last
+    // quarter of the run, deep in the release and reverb tail.
+    double headP50Us = 0.0;
+    double headP99Us = 0.0;
+    double tailP50Us = 0.0;
+    double tailP99Us = 0.0;
+    // RMS of the rendered output, so a change that silences an engine
+    // shows up next to the timings.
+    double outputRms = 0.0;
+#if defined(FLUES_PROFILE)
+    // Per-stage cost from the engine's Profiler, in ns per output sample;
+    // only filled for engines that have one.
+    bool profiled = false;
+    std::array<double, flues::pm::kProfileStageCount> stageNsPerSample{};
+#endif
+};
+
+// A benchmark case: one engine with one variant (interface type or
+// algorithm) applied.
+struct BenchCase {
+    std::string engine;
+    std::string variant;
+    std::function<RunResult(const RunConfig&)> run;
+};
+
+using CaseList = std::vector<BenchCase>;
+
+// Chords stack fourths above the root, folded back into MIDI notes
+// 24..107 so every voice of a 32-voice chord gets a distinct note.
+inline int chordNote(int rootNote, int index) {
+    return 24 + (rootNote - 24 + 5 * index) % 84;
+}
+
+inline float midiToFrequency(int note) {
+    return 440.0f * std::pow(2.0f, (static_cast<float>(note) - 69.0f) / 12.0f);
+}
+
+// Nearest-rank percentile of block times in seconds, returned in
+// microseconds; sorts its argument.
+inline double percentileUs(std::vector<double>& times, double p) {
+    if (times.empty()) {
+        return 0.0;
+    }
+    std::sort(times.begin(), times.end());
+    const std::size_t rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(times.size())));
+    return times[std::clamp<std::size_t>(rank, 1, times.size()) - 1] * 1e6;
+}
+
+#if defined(FLUES_PROFILE)
+template <class Engine, class = void>
+struct HasProfiler : std::false_type {};
+
+template <class Engine>
+struct HasProfiler<Engine, std::void_t<decltype(std::declval<Engine&>().getProfiler())>>
+    : std::true_type {};
+
+// Empties the engine's profile ring into `ticks`, so it never fills up
+// during a run. Called outside the timed region.
+template <class Engine>
+void drainProfile(Engine& engine, std::array<uint64_t, flues::pm::kProfileStageCount>& ticks) {
+    if constexpr (HasProfiler<Engine>::value) {
+        flues::pm::ProfileBlock block;
+        while (engine.getProfiler().pop(block)) {
+            for (std::size_t stage = 0; stage < ticks.size(); ++stage) {
+                ticks[stage] += block.ticks[stage];
+            }
+        }
+    } else {
+        (void)engine;
+        (void)ticks;
+    }
+}
+#endif
+
+/**
+ * The scripted sequence every case plays, as fractions of the run
+ * (r = RunConfig::releaseAt, 0.6 by default):
+ *
+ *   0.0     note (or chord) on
+ *   0.5 r   second note (or chord) on, over the first
+ *   r       all notes off; the rest is release and reverb tail
+ *
+ * plus a parameter change every eighth of the run so the coefficient
+ * update paths are timed too. Events land on block boundaries.
+ *
+ * The Adapter supplies the engine-specific calls:
+ *
+ *   static std::unique_ptr<Engine> create(const RunConfig&);
+ *   static void notesOn(Engine&, int rootNote, int voices);
+ *   static void notesOff(Engine&, int rootNote, int voices);
+ *   static void sweep(Engine&, float amount);   // amount in 0..1
+ *   static int voices(const RunConfig&);         // voices actually played
+ *
+ * and `configure` applies the case's variant to a fresh engine.
+ */
+template <class Adapter, class Configure>
+RunResult runScript(const RunConfig& config, Configure configure) {
+    using Clock = std::chrono::steady_clock;
+
+    std::unique_ptr<flues::pm::DenormalGuard> denormalGuard;
+    if (config.flushDenormals) {
+        denormalGuard = std::make_unique<flues::pm::DenormalGuard>();
+    }
+
+    auto engine = Adapter::create(config);
+    configure(*engine);
+
+    const int voices = Adapter::voices(config);
+    const uint64_t totalFrames = static_cast<uint64_t>(config.seconds * config.sampleRate);
+    const uint64_t notesOffAt = static_cast<uint64_t>(static_cast<double>(totalFrames) * config.releaseAt);
+    const uint64_t secondNoteAt = notesOffAt / 2;
+    const uint64_t sweepInterval = std::max<uint64_t>(totalFrames / 8, 1);
+
+    std::vector<float> out(config.blockSize);
+    std::vector<double> blockTimes;
+    blockTimes.reserve(static_cast<std::size_t>(totalFrames / config.blockSize + 1));
+
+    // Touch the output buffer and the engine's code once before timing.
+    engine->processBlock(out.data(), config.blockSize);
+#if defined(FLUES_PROFILE)
+    std::array<uint64_t, flues::pm::kProfileStageCount> stageTicks{};
+    drainProfile(*engine, stageTicks);
+    stageTicks.fill(0);
+#endif
+
+    bool secondNoteDone = false;
+    bool notesOffDone = false;
+    uint64_t nextSweep = sweepInterval;
+    int sweepStep = 0;
+    double energy = 0.0;
+
+    Adapter::notesOn(*engine, 48, voices);
+
+    double total = 0.0;
+    uint64_t frame = 0;
+    while (frame < totalFrames) {
+        const uint32_t frames = static_cast<uint32_t>(std::min<uint64_t>(config.blockSize, totalFrames - frame));
+
+        const auto start = Clock::now();
+        if (!secondNoteDone && frame >= secondNoteAt) {
+            Adapter::notesOn(*engine, 55, voices);
+            secondNoteDone = true;
+        }
+        if (!notesOffDone && frame >= notesOffAt) {
+            Adapter::notesOff(*engine, 48, voices);
+            Adapter::notesOff(*engine, 55, voices);
+            notesOffDone = true;
+        }
+        if (frame >= nextSweep) {
+            ++sweepStep;
+            Adapter::sweep(*engine, static_cast<float>(sweepStep % 8) / 7.0f);
+            nextSweep += sweepInterval;
+        }
+        engine->processBlock(out.data(), frames);
+        const auto end = Clock::now();
+
+        const double elapsed = std::chrono::duration<double>(end - start).count();
+        blockTimes.push_back(elapsed);
+        total += elapsed;
+#if defined(FLUES_PROFILE)
+        drainProfile(*engine, stageTicks);
+#endif
+
+        for (uint32_t i = 0; i < frames; ++i) {
+            energy += static_cast<double>(out[i]) * out[i];
+        }
+        frame += frames;
+    }
+
+    RunResult result;
+    result.frames = totalFrames;
+    result.blocks = blockTimes.size();
+    result.voices = voices;
+    result.totalSeconds = total;
+    if (totalFrames > 0) {
+        result.nsPerSample = total * 1e9 / static_cast<double>(totalFrames);
+        result.outputRms = std::sqrt(energy / static_cast<double>(totalFrames));
+    }
+#if defined(FLUES_PROFILE)
+    result.profiled = HasProfiler<std::remove_reference_t<decltype(*engine)>>::value;
+    if (result.profiled && totalFrames > 0) {
+        const double nsPerTick = 1e9 / flues::pm::profileTicksPerSecond();
+        for (std::size_t stage = 0; stage < stageTicks.size(); ++stage) {
+            result.stageNsPerSample[stage] =
+                static_cast<double>(stageTicks[stage]) * nsPerTick / static_cast<double>(totalFrames);
+        }
+    }
+#endif
+    if (total > 0.0) {
+        result.realtimeFactor = (static_cast<double>(totalFrames) / config.sampleRate) / total;
+    }
+
+    if (!blockTimes.empty()) {
+        const std::size_t headBlocks = static_cast<std::size_t>(notesOffAt / config.blockSize);
+        const std::size_t tailStart = blockTimes.size() - blockTimes.size() / 4;
+        std::vector<double> head(blockTimes.begin(), blockTimes.begin() + std::min(headBlocks, blockTimes.size()));
+        std::vector<double> tail(blockTimes.begin() + tailStart, blockTimes.end());
+
+        result.blockP50Us = percentileUs(blockTimes, 0.50);
+        result.blockP99Us = percentileUs(blockTimes, 0.99);
+        result.blockMaxUs = percentileUs(blockTimes, 1.0);
+        result.headP50Us = percentileUs(head, 0.50);
+        result.headP99Us = percentileUs(head, 0.99);
+        result.tailP50Us = percentileUs(tail, 0.50);
+        result.tailP99Us = percentileUs(tail, 0.99);
+    }
+    return result;
+}
+
+// Variant names shared by the engines that use them.
+inline const char* const kInterfaceNames[12] = {
+    "pluck", "hit", "reed", "flute", "brass", "bow",
+    "bell", "drum", "crystal", "vapor", "quantum", "plasma"
+};
+
+inline const char* const kAlgorithmNames[7] = {
+    "dirichlet", "dsf-single", "dsf-double", "tanh-square", "tanh-saw", "paf", "mod-fm"
+};
+
+// Registration hooks, one translation unit per engine family.
+void addPMSynthCases(CaseList& cases);
+void addFloozyCases(CaseList& cases);
+void addFloozyPolyCases(CaseList& cases);
+void addDisynCases(CaseList& cases);
+void addDisynPolyCases(CaseList& cases);
+
+} // namespace flues::bench
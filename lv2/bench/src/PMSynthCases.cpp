@@ -0,0 +1,47 @@
+#include "Harness.hpp"
+
+#include "../../pm-synth/src/PMSynthEngine.hpp"
+
+namespace flues::bench {
+
+namespace {
+
+using flues::pm::PMSynthEngine;
+
+struct PMSynthAdapter {
+    static std::unique_ptr<PMSynthEngine> create(const RunConfig& config) {
+        auto engine = std::make_unique<PMSynthEngine>(config.sampleRate);
+        engine->seed(config.seed);
+        return engine;
+    }
+
+    // Monophonic: each note replaces the last.
+    static int voices(const RunConfig&) { return 1; }
+
+    static void notesOn(PMSynthEngine& engine, int rootNote, int) {
+        engine.noteOn(midiToFrequency(rootNote));
+    }
+
+    static void notesOff(PMSynthEngine& engine, int, int) {
+        engine.noteOff();
+    }
+
+    static void sweep(PMSynthEngine& engine, float amount) {
+        engine.setFilterFrequency(amount);
+        engine.setInterfaceIntensity(0.25f + 0.5f * amount);
+    }
+};
+
+} // namespace
+
+void addPMSynthCases(CaseList& cases) {
+    for (int type = 0; type < 12; ++type) {
+        cases.push_back({"pm-synth", kInterfaceNames[type], [type](const RunConfig& config) {
+            return runScript<PMSynthAdapter>(config, [type](PMSynthEngine& engine) {
+                engine.setInterfaceType(static_cast<float>(type));
+            });
+        }});
+    }
+}
+
+} // namespace flues::bench
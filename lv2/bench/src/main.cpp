@@ -0,0 +1,345 @@
+// flues-bench: renders every engine offline through a scripted note and
+// parameter sequence and reports per-sample cost and block-time
+// percentiles, as a table on stderr and optionally as JSON for comparing
+// runs across commits.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Harness.hpp"
+
+#ifndef FLUES_BENCH_REVISION
+#define FLUES_BENCH_REVISION "unknown"
+#endif
+
+namespace {
+
+using namespace flues::bench;
+
+struct Options {
+    std::vector<std::string> engines;
+    std::vector<float> sampleRates{44100.0f, 48000.0f, 96000.0f};
+    std::vector<uint32_t> blockSizes{16, 64, 256, 1024, 2048};
+    double seconds = 1.0;
+    int voices = 8;
+    uint32_t threads = 1;
+    bool tails = false;
+    bool flushDenormals = true;
+    std::string label;
+    std::string output;
+};
+
+void printUsage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s [options]\n"
+                 "  --engine NAME      pm-synth, floozy, floozy-poly, disyn or disyn-poly\n"
+                 "                     (repeatable; default: all)\n"
+                 "  --rate HZ          sample rate (repeatable; default: 44100 48000 96000)\n"
+                 "  --block N          block size, 1..2048 (repeatable; default: 16 64 256 1024 2048)\n"
+                 "  --seconds S        rendered length per case (default: 1)\n"
+                 "  --voices N         chord size for the polyphonic engines (default: 8)\n"
+                 "  --threads N        render threads for floozy-poly (default: 1)\n"
+                 "  --quick            48 kHz, blocks 64 and 1024, 0.25 s per case\n"
+                 "  --tails            denormal check: 1 s of notes then a long tail (default 20 s,\n"
+                 "                     48 kHz, block 128); fails if tail blocks cost more than held ones\n"
+                 "  --no-ftz           render without the DenormalGuard the plugins' run() opens\n"
+                 "  --label TEXT       free-form label stored in the JSON\n"
+                 "  --output FILE      write JSON results to FILE ('-' for stdout)\n",
+                 program);
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    std::vector<float> rates;
+    std::vector<uint32_t> blocks;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto next = [&]() -> const char* {
+            return i + 1 < argc ? argv[++i] : nullptr;
+        };
+
+        if (arg == "--quick") {
+            options.sampleRates = {48000.0f};
+            options.blockSizes = {64, 1024};
+            options.seconds = 0.25;
+            continue;
+        }
+        if (arg == "--tails") {
+            options.tails = true;
+            options.sampleRates = {48000.0f};
+            options.blockSizes = {128};
+            options.seconds = 20.0;
+            continue;
+        }
+        if (arg == "--no-ftz") {
+            options.flushDenormals = false;
+            continue;
+        }
+        if (arg == "--help" || arg == "-h") {
+            return false;
+        }
+
+        const char* value = next();
+        if (!value) {
+            std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+            return false;
+        }
+        if (arg == "--engine") {
+            options.engines.emplace_back(value);
+        } else if (arg == "--rate") {
+            rates.push_back(std::strtof(value, nullptr));
+        } else if (arg == "--block") {
+            blocks.push_back(static_cast<uint32_t>(std::strtoul(value, nullptr, 10)));
+        } else if (arg == "--seconds") {
+            options.seconds = std::strtod(value, nullptr);
+        } else if (arg == "--voices") {
+            options.voices = std::atoi(value);
+        } else if (arg == "--threads") {
+            options.threads = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--label") {
+            options.label = value;
+        } else if (arg == "--output") {
+            options.output = value;
+        } else {
+            std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    if (!rates.empty()) {
+        options.sampleRates = rates;
+    }
+    if (!blocks.empty()) {
+        options.blockSizes = blocks;
+    }
+    for (float rate : options.sampleRates) {
+        if (!(rate >= 8000.0f && rate <= 384000.0f)) {
+            std::fprintf(stderr, "sample rate out of range: %g\n", rate);
+            return false;
+        }
+    }
+    for (uint32_t block : options.blockSizes) {
+        if (block < 1 || block > 2048) {
+            std::fprintf(stderr, "block size out of range: %u\n", block);
+            return false;
+        }
+    }
+    if (!(options.seconds > 0.0) || options.voices < 1 || options.threads < 1) {
+        std::fprintf(stderr, "--seconds, --voices and --threads must be positive\n");
+        return false;
+    }
+    return true;
+}
+
+bool wanted(const Options& options, const std::string& engine) {
+    if (options.engines.empty()) {
+        return true;
+    }
+    for (const auto& name : options.engines) {
+        if (name == engine) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// A tail block does strictly less work than a block with notes held, so a
+// median tail block costing more than this multiple of a held one means
+// the decaying state has gone subnormal.
+constexpr double kTailLimit = 1.5;
+
+struct Row {
+    const BenchCase* benchCase;
+    RunConfig config;
+    RunResult result;
+};
+
+// Labels and variant names are plain ASCII; only quotes, backslashes and
+// control characters need escaping.
+std::string jsonString(const std::string& text) {
+    std::string escaped = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            escaped += buffer;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped + "\"";
+}
+
+#if defined(FLUES_PROFILE)
+// Comma-prefixed "stages" member for a result row, empty when the engine
+// has no profiler.
+std::string jsonStages(const RunResult& result) {
+    if (!result.profiled) {
+        return "";
+    }
+    std::string stages = ", \"stagesNsPerSample\": {";
+    for (std::size_t stage = 0; stage < flues::pm::kProfileStageCount; ++stage) {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%s\"%s\": %.3f", stage > 0 ? ", " : "",
+                      flues::pm::profileStageName(stage), result.stageNsPerSample[stage]);
+        stages += buffer;
+    }
+    return stages + "}";
+}
+
+void printStages(const RunResult& result) {
+    if (!result.profiled) {
+        return;
+    }
+    std::fprintf(stderr, "%30s", "ns/smp by stage:");
+    for (std::size_t stage = 0; stage < flues::pm::kProfileStageCount; ++stage) {
+        std::fprintf(stderr, " %s %.2f", flues::pm::profileStageName(stage), result.stageNsPerSample[stage]);
+    }
+    std::fprintf(stderr, "\n");
+}
+#endif
+
+void writeJson(std::FILE* file, const Options& options, const std::vector<Row>& rows) {
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"tool\": \"flues-bench\",\n");
+    std::fprintf(file, "  \"revision\": %s,\n", jsonString(FLUES_BENCH_REVISION).c_str());
+    std::fprintf(file, "  \"label\": %s,\n", jsonString(options.label).c_str());
+#if defined(__clang__)
+    std::fprintf(file, "  \"compiler\": %s,\n", jsonString("clang " __clang_version__).c_str());
+#elif defined(__GNUC__)
+    std::fprintf(file, "  \"compiler\": %s,\n", jsonString("gcc " __VERSION__).c_str());
+#else
+    std::fprintf(file, "  \"compiler\": \"unknown\",\n");
+#endif
+    std::fprintf(file, "  \"seconds\": %g,\n", options.seconds);
+    std::fprintf(file, "  \"threads\": %u,\n", options.threads);
+    std::fprintf(file, "  \"flushDenormals\": %s,\n", options.flushDenormals ? "true" : "false");
+#if defined(FLUES_PROFILE)
+    std::fprintf(file, "  \"profile\": true,\n");
+#endif
+    std::fprintf(file, "  \"results\": [\n");
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        const Row& row = rows[i];
+        const RunResult& r = row.result;
+#if defined(FLUES_PROFILE)
+        const std::string stages = jsonStages(r);
+#else
+        const std::string stages;
+#endif
+        std::fprintf(file,
+                     "    {\"engine\": %s, \"variant\": %s, \"sampleRate\": %g, \"blockSize\": %u, "
+                     "\"voices\": %d, \"frames\": %llu, \"nsPerSample\": %.3f, "
+                     "\"realtimeFactor\": %.2f, \"blockUs\": {\"p50\": %.3f, \"p99\": %.3f, \"max\": %.3f}, "
+                     "\"headUs\": {\"p50\": %.3f, \"p99\": %.3f}, \"tailUs\": {\"p50\": %.3f, \"p99\": %.3f}, "
+                     "\"rms\": %.6f%s}%s\n",
+                     jsonString(row.benchCase->engine).c_str(),
+                     jsonString(row.benchCase->variant).c_str(),
+                     row.config.sampleRate, row.config.blockSize, r.voices,
+                     static_cast<unsigned long long>(r.frames),
+                     r.nsPerSample, r.realtimeFactor,
+                     r.blockP50Us, r.blockP99Us, r.blockMaxUs,
+                     r.headP50Us, r.headP99Us, r.tailP50Us, r.tailP99Us, r.outputRms, stages.c_str(),
+                     i + 1 < rows.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    CaseList cases;
+    addPMSynthCases(cases);
+    addFloozyCases(cases);
+    addFloozyPolyCases(cases);
+    addDisynCases(cases);
+    addDisynPolyCases(cases);
+
+    std::vector<Row> rows;
+    int failures = 0;
+    if (options.tails) {
+        std::fprintf(stderr, "%-12s %-12s %7s %5s %3s %10s %10s %10s %10s\n",
+                     "engine", "variant", "rate", "block", "vc",
+                     "held p50", "tail p50", "held p99", "tail p99");
+    } else {
+        std::fprintf(stderr, "%-12s %-12s %7s %5s %3s %9s %9s %9s %9s %9s\n",
+                     "engine", "variant", "rate", "block", "vc",
+                     "ns/smp", "x rt", "p50 us", "p99 us", "max us");
+    }
+    for (const BenchCase& benchCase : cases) {
+        if (!wanted(options, benchCase.engine)) {
+            continue;
+        }
+        for (float rate : options.sampleRates) {
+            for (uint32_t block : options.blockSizes) {
+                RunConfig config;
+                config.sampleRate = rate;
+                config.blockSize = block;
+                config.seconds = options.seconds;
+                config.voices = options.voices;
+                config.threads = options.threads;
+                config.flushDenormals = options.flushDenormals;
+                if (options.tails) {
+                    // One second of notes, the rest is tail.
+                    config.releaseAt = std::min(0.5, 1.0 / options.seconds);
+                }
+
+                const RunResult result = benchCase.run(config);
+                rows.push_back({&benchCase, config, result});
+                if (options.tails) {
+                    const bool blownUp = result.tailP50Us > kTailLimit * result.headP50Us;
+                    failures += blownUp ? 1 : 0;
+                    std::fprintf(stderr, "%-12s %-12s %7g %5u %3d %10.2f %10.2f %10.2f %10.2f%s\n",
+                                 benchCase.engine.c_str(), benchCase.variant.c_str(),
+                                 rate, block, result.voices,
+                                 result.headP50Us, result.tailP50Us, result.headP99Us, result.tailP99Us,
+                                 blownUp ? "  FAIL" : "");
+                } else {
+                    std::fprintf(stderr, "%-12s %-12s %7g %5u %3d %9.2f %9.1f %9.2f %9.2f %9.2f\n",
+                                 benchCase.engine.c_str(), benchCase.variant.c_str(),
+                                 rate, block, result.voices, result.nsPerSample, result.realtimeFactor,
+                                 result.blockP50Us, result.blockP99Us, result.blockMaxUs);
+#if defined(FLUES_PROFILE)
+                    printStages(result);
+#endif
+                }
+            }
+        }
+    }
+
+    if (rows.empty()) {
+        std::fprintf(stderr, "no cases matched\n");
+        return 1;
+    }
+
+    if (!options.output.empty()) {
+        const bool toStdout = options.output == "-";
+        std::FILE* file = toStdout ? stdout : std::fopen(options.output.c_str(), "w");
+        if (!file) {
+            std::fprintf(stderr, "cannot open %s\n", options.output.c_str());
+            return 1;
+        }
+        writeJson(file, options, rows);
+        if (!toStdout) {
+            std::fclose(file);
+        }
+    }
+
+    if (failures > 0) {
+        std::fprintf(stderr, "%d case(s) got slower in the tail than with notes held\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "../../disyn/src/modules/OscillatorModule.hpp"
+#include "../../disyn/src/modules/EnvelopeModule.hpp"
+#include "../../disyn/src/modules/ReverbModule.hpp"
+#include "../../pm-synth/src/VoiceAllocator.hpp"
+
+namespace flues::disyn_poly {
+
+using flues::disyn::AlgorithmType;
+
+// One Disyn voice: oscillator and envelope, rendered a block at a time and
+// mixed into the bus.
+class DisynVoice {
+public:
+    static constexpr uint32_t kMaxBlockSize = 64;
+
+    explicit DisynVoice(float sampleRate = 44100.0f)
+        : oscillator_(sampleRate),
+          envelope_(sampleRate),
+          gain_(0.0f),
+          active_(false) {}
+
+    void noteOn(float frequency, float velocity,
+                AlgorithmType algorithm, float param1, float param2) {
+        gain_ = velocity;
+        active_ = true;
+        frequency_.fill(frequency);
+
+        oscillator_.setParameters(algorithm, param1, param2);
+        oscillator_.reset();
+        envelope_.reset();
+        envelope_.setGate(true);
+    }
+
+    void noteOff() {
+        if (!active_) {
+            return;
+        }
+        envelope_.setGate(false);
+    }
+
+    void forceStop() {
+        active_ = false;
+        envelope_.setGate(false);
+    }
+
+    void setAttack(float value) { envelope_.setAttack(value); }
+    void setRelease(float value) { envelope_.setRelease(value); }
+
+    // Adds `frames` (<= kMaxBlockSize) samples of this voice to `bus`.
+    void render(float* bus, uint32_t frames, AlgorithmType algorithm,
+                float param1, float param2, float masterGain) {
+        oscillator_.processBlock(algorithm, param1, param2, frequency_.data(), scratch_.data(), frames);
+
+        const float gain = gain_ * masterGain;
+        for (uint32_t i = 0; i < frames; ++i) {
+            bus[i] += scratch_[i] * envelope_.process() * gain;
+        }
+
+        if (!envelope_.isPlaying()) {
+            active_ = false;
+        }
+    }
+
+    bool isActive() const { return active_; }
+
+private:
+    flues::disyn::OscillatorModule oscillator_;
+    flues::disyn::EnvelopeModule envelope_;
+
+    float gain_;
+    bool active_;
+
+    std::array<float, kMaxBlockSize> frequency_{};
+    std::array<float, kMaxBlockSize> scratch_{};
+};
+
+/**
+ * Polyphonic Disyn: a fixed pool of kMaxVoices voices, all allocated up
+ * front, summed into one bus that feeds a single reverb.
+ *
+ * Voices are handed out by flues::pm::VoiceAllocator, as in floozy-dev and
+ * floozy-poly: a retrigger reuses the note's voice, otherwise the lowest
+ * idle voice, otherwise the earliest released voice is stolen, otherwise
+ * the oldest held one. All of it is O(1) and only sounding voices render.
+ */
+class DisynPolyEngine {
+public:
+    static constexpr std::size_t kMaxVoices = 32;
+    static constexpr uint32_t kMaxBlockSize = DisynVoice::kMaxBlockSize;
+
+    explicit DisynPolyEngine(float sampleRate = 44100.0f)
+        : sampleRate_(sampleRate),
+          reverb_(sampleRate),
+          algorithm_(AlgorithmType::TANH_SQUARE),
+          param1_(0.55f),
+          param2_(0.5f),
+          attack_(-1.0f),   // voices keep the envelope defaults until first set
+          release_(-1.0f),
+          masterGain_(0.8f) {
+        voices_.fill(DisynVoice(sampleRate));
+    }
+
+    void noteOn(int midiNote, float frequency, float velocity = 1.0f) {
+        if (!VoiceAllocator::isValidNote(midiNote)) {
+            return;
+        }
+        voices_[allocator_.noteOn(midiNote)].noteOn(frequency, std::clamp(velocity, 0.0f, 1.0f),
+                                                    algorithm_, param1_, param2_);
+    }
+
+    void noteOff(int midiNote) {
+        const int slot = allocator_.noteOff(midiNote);
+        if (slot != VoiceAllocator::kNoVoice) {
+            voices_[static_cast<std::size_t>(slot)].noteOff();
+        }
+    }
+
+    void allNotesOff() {
+        for (auto& voice : voices_) {
+            voice.forceStop();
+        }
+        allocator_.reset(kMaxVoices);
+        reverb_.reset();
+    }
+
+    // Same as allNotesOff(), parameters kept. Allocation-free, so
+    // activate() can call it instead of rebuilding the engine.
+    void resetAll() {
+        allNotesOff();
+    }
+
+    float process() {
+        float sample = 0.0f;
+        processBlock(&sample, 1);
+        return sample;
+    }
+
+    // Renders `frames` samples: every active voice is summed into `out`,
+    // then the bus goes through the reverb once.
+    void processBlock(float* out, uint32_t frames) {
+        std::fill(out, out + frames, 0.0f);
+
+        for (uint32_t done = 0; done < frames; done += kMaxBlockSize) {
+            const uint32_t n = std::min(frames - done, kMaxBlockSize);
+            // Only the sounding voices, in slot order.
+            for (uint64_t active = allocator_.activeMask(); active != 0; active &= active - 1) {
+                const auto slot = static_cast<std::size_t>(__builtin_ctzll(active));
+                DisynVoice& voice = voices_[slot];
+                voice.render(out + done, n, algorithm_, param1_, param2_, masterGain_);
+                if (!voice.isActive()) {
+                    allocator_.voiceStopped(slot);
+                }
+            }
+        }
+
+        // The reverb bypasses itself while idle and the bus is silent.
+        reverb_.processBlock(out, frames);
+    }
+
+    // Parameter setters
+    void setAlgorithm(int type) {
+        if (type >= 0 && type <= 6) {
+            algorithm_ = static_cast<AlgorithmType>(type);
+        }
+    }
+
+    void setParam1(float value) { param1_ = std::clamp(value, 0.0f, 1.0f); }
+    void setParam2(float value) { param2_ = std::clamp(value, 0.0f, 1.0f); }
+
+    void setAttack(float value) {
+        if (value != attack_) {
+            attack_ = value;
+            for (auto& voice : voices_) {
+                voice.setAttack(value);
+            }
+        }
+    }
+
+    void setRelease(float value) {
+        if (value != release_) {
+            release_ = value;
+            for (auto& voice : voices_) {
+                voice.setRelease(value);
+            }
+        }
+    }
+
+    void setReverbSize(float value) { reverb_.setSize(value); }
+    void setReverbLevel(float value) { reverb_.setLevel(value); }
+    void setReverbMode(float value) { reverb_.setMode(static_cast<int>(std::round(value))); }
+    void setMasterGain(float value) { masterGain_ = std::clamp(value, 0.0f, 1.0f); }
+
+    std::size_t activeVoiceCount() const {
+        return static_cast<std::size_t>(__builtin_popcountll(allocator_.activeMask()));
+    }
+
+private:
+    using VoiceAllocator = flues::pm::VoiceAllocator<kMaxVoices>;
+
+    float sampleRate_;
+    std::array<DisynVoice, kMaxVoices> voices_;
+    VoiceAllocator allocator_;
+    flues::disyn::ReverbModule reverb_;
+
+    AlgorithmType algorithm_;
+    float param1_;
+    float param2_;
+    float attack_;
+    float release_;
+    float masterGain_;
+};
+
+} // namespace flues::disyn_poly
@@ -0,0 +1,235 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <algorithm>
+
+#include <lv2/core/lv2.h>
+#include <lv2/atom/atom.h>
+#include <lv2/atom/util.h>
+#include <lv2/midi/midi.h>
+#include <lv2/urid/urid.h>
+
+#include "DisynPolyEngine.hpp"
+#include "../../pm-synth/src/DenormalGuard.hpp"
+#include "../../pm-synth/src/PortCache.hpp"
+
+#define DISYN_POLY_URI "https://danja.github.io/flues/plugins/disyn-poly"
+
+namespace flues::disyn_poly {
+
+enum PortIndex : uint32_t {
+    PORT_AUDIO_OUT = 0,
+    PORT_MIDI_IN,
+    PORT_ALGORITHM_TYPE,
+    PORT_PARAM_1,
+    PORT_PARAM_2,
+    PORT_ENVELOPE_ATTACK,
+    PORT_ENVELOPE_RELEASE,
+    PORT_REVERB_SIZE,
+    PORT_REVERB_LEVEL,
+    PORT_MASTER_GAIN,
+    PORT_REVERB_MODE,
+    PORT_TOTAL_COUNT
+};
+
+using ControlPorts = flues::pm::PortCache<PORT_TOTAL_COUNT>;
+
+struct DisynPolyLV2 {
+    std::unique_ptr<DisynPolyEngine> engine;
+    float sampleRate;
+
+    const LV2_Atom_Sequence* midiIn;
+    float* audioOut;
+
+    ControlPorts controls;
+
+    LV2_URID_Map* map;
+    LV2_URID midiEventUrid;
+    LV2_URID atomSequenceUrid;
+
+};
+
+static void apply_parameters(DisynPolyLV2* self) {
+    if (!self->engine) {
+        return;
+    }
+
+    const ControlPorts::Mask dirty = self->controls.poll();
+    if (!dirty) {
+        return;
+    }
+
+    auto apply = [&](uint32_t port, auto setter) {
+        if (dirty & ControlPorts::bit(port)) {
+            (self->engine.get()->*setter)(self->controls.value(port));
+        }
+    };
+
+    if (dirty & ControlPorts::bit(PORT_ALGORITHM_TYPE)) {
+        self->engine->setAlgorithm(static_cast<int>(std::round(self->controls.value(PORT_ALGORITHM_TYPE))));
+    }
+    apply(PORT_PARAM_1, &DisynPolyEngine::setParam1);
+    apply(PORT_PARAM_2, &DisynPolyEngine::setParam2);
+    apply(PORT_ENVELOPE_ATTACK, &DisynPolyEngine::setAttack);
+    apply(PORT_ENVELOPE_RELEASE, &DisynPolyEngine::setRelease);
+    apply(PORT_REVERB_SIZE, &DisynPolyEngine::setReverbSize);
+    apply(PORT_REVERB_LEVEL, &DisynPolyEngine::setReverbLevel);
+    apply(PORT_MASTER_GAIN, &DisynPolyEngine::setMasterGain);
+    apply(PORT_REVERB_MODE, &DisynPolyEngine::setReverbMode);
+}
+
+static void handle_midi(DisynPolyLV2* self, const uint8_t* msg, uint32_t size) {
+    if (size < 1 || !self->engine) {
+        return;
+    }
+
+    const uint8_t status = msg[0] & 0xF0U;
+    const uint8_t data1 = size > 1 ? msg[1] : 0;
+    const uint8_t data2 = size > 2 ? msg[2] : 0;
+
+    switch (status) {
+        case LV2_MIDI_MSG_NOTE_ON: {
+            if (data2 == 0) {
+                // Note on with velocity 0 is note off
+                self->engine->noteOff(data1);
+                break;
+            }
+            const float freq = 440.0f * std::pow(2.0f, (static_cast<int>(data1) - 69) / 12.0f);
+            const float velocity = static_cast<float>(data2) / 127.0f;
+            self->engine->noteOn(data1, freq, velocity);
+            break;
+        }
+        case LV2_MIDI_MSG_NOTE_OFF:
+            self->engine->noteOff(data1);
+            break;
+        case LV2_MIDI_MSG_CONTROLLER: {
+            if (data1 == LV2_MIDI_CTL_ALL_SOUNDS_OFF || data1 == LV2_MIDI_CTL_ALL_NOTES_OFF) {
+                self->engine->allNotesOff();
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+} // namespace flues::disyn_poly
+
+extern "C" {
+
+static LV2_Handle instantiate(const LV2_Descriptor*, double rate,
+                              const char*, const LV2_Feature* const* features) {
+    using namespace flues::disyn_poly;
+
+    auto* self = new DisynPolyLV2();
+    self->sampleRate = static_cast<float>(rate);
+    self->engine = std::make_unique<DisynPolyEngine>(self->sampleRate);
+    self->midiIn = nullptr;
+    self->audioOut = nullptr;
+
+    self->map = nullptr;
+    self->midiEventUrid = 0;
+
+    for (const LV2_Feature* const* f = features; f && *f; ++f) {
+        if (!strcmp((*f)->URI, LV2_URID__map)) {
+            self->map = static_cast<LV2_URID_Map*>((*f)->data);
+        }
+    }
+
+    if (!self->map) {
+        delete self;
+        return nullptr;
+    }
+
+    self->midiEventUrid = self->map->map(self->map->handle, LV2_MIDI__MidiEvent);
+    self->atomSequenceUrid = self->map->map(self->map->handle, LV2_ATOM__Sequence);
+
+    return self;
+}
+
+static void cleanup(LV2_Handle instance) {
+    auto* self = static_cast<flues::disyn_poly::DisynPolyLV2*>(instance);
+    delete self;
+}
+
+static void connect_port(LV2_Handle instance, uint32_t port, void* data) {
+    using namespace flues::disyn_poly;
+    auto* self = static_cast<DisynPolyLV2*>(instance);
+
+    switch (port) {
+        case PORT_AUDIO_OUT: self->audioOut = static_cast<float*>(data); break;
+        case PORT_MIDI_IN: self->midiIn = static_cast<const LV2_Atom_Sequence*>(data); break;
+        default: self->controls.connect(port, static_cast<const float*>(data)); break;
+    }
+}
+
+static void activate(LV2_Handle instance) {
+    auto* self = static_cast<flues::disyn_poly::DisynPolyLV2*>(instance);
+    if (!self || !self->engine) {
+        return;
+    }
+    self->engine->resetAll();
+}
+
+static void run(LV2_Handle instance, uint32_t n_samples) {
+    using namespace flues::disyn_poly;
+    auto* self = static_cast<DisynPolyLV2*>(instance);
+    if (!self || !self->audioOut) {
+        return;
+    }
+
+    const flues::pm::DenormalGuard denormalGuard;
+
+    apply_parameters(self);
+
+    float* out = self->audioOut;
+
+    uint32_t frame = 0;
+
+    if (self->midiIn && self->midiIn->atom.type == self->atomSequenceUrid) {
+        LV2_ATOM_SEQUENCE_FOREACH(self->midiIn, ev) {
+            const uint32_t eventFrame = ev->time.frames >= 0
+                ? static_cast<uint32_t>(ev->time.frames)
+                : 0u;
+
+            if (frame < eventFrame) {
+                const uint32_t limit = std::min(eventFrame, n_samples);
+                self->engine->processBlock(out + frame, limit - frame);
+                frame = limit;
+            }
+
+            if (ev->body.type == self->midiEventUrid) {
+                const uint8_t* msg = reinterpret_cast<const uint8_t*>(ev + 1);
+                handle_midi(self, msg, ev->body.size);
+            }
+        }
+    }
+
+    if (frame < n_samples) {
+        self->engine->processBlock(out + frame, n_samples - frame);
+    }
+}
+
+static void deactivate(LV2_Handle) {}
+
+static const void* extension_data(const char*) {
+    return nullptr;
+}
+
+static const LV2_Descriptor descriptor = {
+    DISYN_POLY_URI,
+    instantiate,
+    connect_port,
+    activate,
+    run,
+    deactivate,
+    cleanup,
+    extension_data
+};
+
+const LV2_Descriptor* lv2_descriptor(uint32_t index) {
+    return index == 0 ? &descriptor : nullptr;
+}
+
+} // extern "C"
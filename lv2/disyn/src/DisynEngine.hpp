@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cmath>
+#include <cstdint>
 #include <algorithm>
+#include <array>
 
 #include "modules/OscillatorModule.hpp"
 #include "modules/EnvelopeModule.hpp"
@@ -11,6 +13,9 @@ namespace flues::disyn {
 
 class DisynEngine {
 public:
+    // Largest sub-block rendered in one pass; longer host buffers are split.
+    static constexpr uint32_t kMaxBlockSize = 64;
+
     explicit DisynEngine(float sampleRate = 44100.0f)
         : sampleRate(sampleRate),
           oscillator(sampleRate),
@@ -30,10 +35,11 @@ public:
         velocity = std::clamp(vel, 0.0f, 1.0f);
         gate = true;
         isPlaying = true;
+        frequencyBuffer.fill(frequency);
 
+        oscillator.setParameters(algorithmType, param1, param2);
         oscillator.reset();
         envelope.reset();
-        reverb.reset();
 
         envelope.setGate(true);
     }
@@ -43,29 +49,51 @@ public:
         envelope.setGate(false);
     }
 
+    // Silences the voice and drops the reverb tail, keeping the parameters.
+    // Allocation-free, so activate() can call it instead of rebuilding.
+    void resetAll() {
+        gate = false;
+        isPlaying = false;
+        oscillator.reset();
+        envelope.reset();
+        envelope.setGate(false);
+        reverb.reset();
+    }
+
     float process() {
+        float sample = 0.0f;
+        processBlock(&sample, 1);
+        return sample;
+    }
+
+    // Renders `frames` samples. The reverb is a bus: it is not reset on
+    // note on and keeps ringing after the voice stops, until it goes idle.
+    void processBlock(float* out, uint32_t frames) {
         if (!isPlaying) {
-            return 0.0f;
+            std::fill(out, out + frames, 0.0f);
+            if (!reverb.isIdle()) {
+                reverb.processBlock(out, frames);
+            }
+            return;
         }
 
-        // Generate oscillator sample
-        const float oscSample = oscillator.process(algorithmType, param1, param2, frequency);
-
-        // Apply envelope
-        const float env = envelope.process();
-
-        // Apply velocity and master gain
-        const float sample = oscSample * env * velocity * masterGain;
+        const float gain = velocity * masterGain;
+        for (uint32_t done = 0; done < frames; done += kMaxBlockSize) {
+            const uint32_t n = std::min(frames - done, kMaxBlockSize);
+            float* chunk = out + done;
+            oscillator.processBlock(algorithmType, param1, param2, frequencyBuffer.data(), chunk, n);
+            for (uint32_t i = 0; i < n; ++i) {
+                chunk[i] = chunk[i] * envelope.process() * gain;
+            }
+        }
 
-        // Apply reverb
-        const float output = reverb.process(sample);
+        // Voice tail detection on the dry signal - stop if the envelope is silent
+        const float lastDry = out[frames - 1];
+        reverb.processBlock(out, frames);
 
-        // Voice tail detection - stop if envelope is silent
-        if (!envelope.isPlaying() && std::abs(output) < 1e-5f) {
+        if (!envelope.isPlaying() && std::abs(lastDry) < 1e-5f) {
             isPlaying = false;
         }
-
-        return output;
     }
 
     // Parameter setters
@@ -99,6 +127,10 @@ public:
         reverb.setLevel(value);
     }
 
+    void setReverbMode(float value) {
+        reverb.setMode(static_cast<int>(std::round(value)));
+    }
+
     void setMasterGain(float value) {
         masterGain = std::clamp(value, 0.0f, 1.0f);
     }
@@ -121,6 +153,9 @@ private:
     float velocity;
     bool gate;
     bool isPlaying;
+
+    // The note frequency, repeated for the oscillator's per-sample input.
+    std::array<float, kMaxBlockSize> frequencyBuffer{};
 };
 
 } // namespace flues::disyn
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace flues::disyn::fastmath {
+
+/**
+ * Branch-free replacements for the libm calls on the oscillator hot path.
+ *
+ * Everything here is straight-line arithmetic with selects instead of
+ * branches, so loops calling these functions can be auto-vectorised.
+ * Error bounds against libm over the ranges the oscillators use, checked by
+ * tests/fastmath_check.cpp:
+ *
+ *   sin2pi / cos2pi   absolute error < 5e-7   (phase in cycles, |phase| < 64)
+ *   exp2              relative error < 6e-7   (|x| <= 126)
+ *   exp               relative error < 2e-6   (|x| < 16)
+ *   tanh              absolute error < 5e-7
+ *
+ * Each bound is twice an estimate of truncation plus float rounding, so a
+ * different compiler, libm or FMA contraction stays inside it:
+ *   - sin: Taylor remainder (pi/2)^13 / 13! = 5.7e-8, plus ~1.9e-7 from
+ *     folding the phase and evaluating in float.
+ *   - exp2: remainder of e^f to degree 6 for |f| <= ln(2) / 2 is 1.7e-7,
+ *     plus ~1.2e-7 of rounding in the Horner chain.
+ *   - exp: exp2's error plus rounding x * log2(e) to float, up to
+ *     ln(2) * 2^-24 * 23 = 6.6e-7 relative at |x| = 16.
+ *   - tanh: half exp2's relative error, plus the rounding of the division
+ *     and subtraction near 1.
+ *
+ * That is at or below the rounding of a float phase accumulator, so the
+ * change is inaudible; it is not a drop-in for code that needs exact libm
+ * results.
+ *
+ * Rounding goes through a float-to-int conversion rather than the
+ * 1.5 * 2^23 add/subtract trick, which -ffast-math reassociates away.
+ */
+
+inline constexpr float kLog2E = 1.44269504f;
+inline constexpr float kLog2Of10 = 3.32192809f;
+
+// Round to nearest, halfway cases either way. Adding just under one half
+// and truncating keeps the conversion exact (x + 0.5 would round up values
+// just below one half) and vectorises to cvttps2dq. |x| must stay below
+// 2^31; phases and exponents passed to the functions below do.
+inline constexpr float kJustUnderHalf = 0.49999997f;
+
+inline int32_t roundToInt(float x) {
+    return static_cast<int32_t>(x + std::copysign(kJustUnderHalf, x));
+}
+
+inline float roundNearest(float x) {
+    return static_cast<float>(roundToInt(x));
+}
+
+// Value clamp that compiles to minss/maxss.
+inline float clampValue(float x, float lo, float hi) {
+    x = x < lo ? lo : x;
+    return x > hi ? hi : x;
+}
+
+// sin(2 * pi * phase), with phase in cycles.
+inline float sin2pi(float phase) {
+    // Reduce to r in [-0.5, 0.5] cycles, then fold |r| onto [0, 0.25],
+    // where sin is monotonic, and restore the sign at the end.
+    const float r = phase - roundNearest(phase);
+    const float folded = 0.25f - std::abs(std::abs(r) - 0.25f);
+
+    // Degree-11 Taylor series in x = 2 * pi * folded, x <= pi / 2.
+    const float x = folded * 6.28318531f;
+    const float x2 = x * x;
+    const float y = x * (1.0f + x2 * (-1.66666667e-1f + x2 * (8.33333333e-3f + x2 * (
+        -1.98412698e-4f + x2 * (2.75573192e-6f + x2 * -2.50521084e-8f)))));
+    return std::copysign(y, r);
+}
+
+// cos(2 * pi * phase), with phase in cycles.
+inline float cos2pi(float phase) {
+    // cos(2 pi r) = sin(2 pi (1/4 - |r|)). Reducing first keeps large
+    // phases precise; the abs stops -ffast-math from moving the 1/4 back
+    // onto the unreduced phase.
+    return sin2pi(0.25f - std::abs(phase - roundNearest(phase)));
+}
+
+// 2^x, saturating at 2^+-126 (|x| < 2^31).
+inline float exp2(float x) {
+    // Split into a rounded integer and a fraction in [-0.5, 0.5]. The
+    // octave is clamped as an integer: a float clamp here would be threaded
+    // into separate branches and stop the caller's loop from vectorising.
+    int32_t octave = roundToInt(x);
+    const float f = (x - static_cast<float>(octave)) * 0.693147181f;
+    octave = octave < -126 ? -126 : octave;
+    octave = octave > 126 ? 126 : octave;
+    const int32_t bits = (octave + 127) << 23;
+
+    // e^f, degree-6 Taylor series.
+    const float fraction = 1.0f + f * (1.0f + f * (0.5f + f * (1.66666667e-1f + f * (
+        4.16666667e-2f + f * (8.33333333e-3f + f * 1.38888889e-3f)))));
+
+    float scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return fraction * scale;
+}
+
+// e^x.
+inline float exp(float x) {
+    return exp2(x * kLog2E);
+}
+
+// 10^(dB / 20).
+inline float dbToGain(float db) {
+    return exp2(db * (kLog2Of10 / 20.0f));
+}
+
+// tanh(x) = 1 - 2 / (e^2x + 1); exp2 saturating makes large |x| land
+// on exactly +-1.
+inline float tanh(float x) {
+    return 1.0f - 2.0f / (exp2(x * (2.0f * kLog2E)) + 1.0f);
+}
+
+// min * (max / min)^value for value in 0..1. The oscillators pass
+// constant bounds, so the log2 folds away at compile time.
+inline float expoMap(float value, float min, float max) {
+    return min * exp2(clampValue(value, 0.0f, 1.0f) * std::log2(max / min));
+}
+
+} // namespace flues::disyn::fastmath
@@ -11,6 +11,8 @@
 #include <lv2/urid/urid.h>
 
 #include "DisynEngine.hpp"
+#include "../../pm-synth/src/DenormalGuard.hpp"
+#include "../../pm-synth/src/PortCache.hpp"
 
 #define DISYN_URI "https://danja.github.io/flues/plugins/disyn"
 
@@ -27,9 +29,12 @@ enum PortIndex : uint32_t {
     PORT_REVERB_SIZE,
     PORT_REVERB_LEVEL,
     PORT_MASTER_GAIN,
+    PORT_REVERB_MODE,
     PORT_TOTAL_COUNT
 };
 
+using ControlPorts = flues::pm::PortCache<PORT_TOTAL_COUNT>;
+
 struct DisynLV2 {
     std::unique_ptr<DisynEngine> engine;
     float sampleRate;
@@ -37,14 +42,7 @@ struct DisynLV2 {
     const LV2_Atom_Sequence* midiIn;
     float* audioOut;
 
-    const float* algorithmType;
-    const float* param1;
-    const float* param2;
-    const float* attack;
-    const float* release;
-    const float* reverbSize;
-    const float* reverbLevel;
-    const float* masterGain;
+    ControlPorts controls;
 
     LV2_URID_Map* map;
     LV2_URID midiEventUrid;
@@ -58,22 +56,28 @@ static void apply_parameters(DisynLV2* self) {
         return;
     }
 
-    auto apply = [&](const float* port, auto setter) {
-        if (port) {
-            (self->engine.get()->*setter)(*port);
+    const ControlPorts::Mask dirty = self->controls.poll();
+    if (!dirty) {
+        return;
+    }
+
+    auto apply = [&](uint32_t port, auto setter) {
+        if (dirty & ControlPorts::bit(port)) {
+            (self->engine.get()->*setter)(self->controls.value(port));
         }
     };
 
-    if (self->algorithmType) {
-        self->engine->setAlgorithm(static_cast<int>(std::round(*self->algorithmType)));
+    if (dirty & ControlPorts::bit(PORT_ALGORITHM_TYPE)) {
+        self->engine->setAlgorithm(static_cast<int>(std::round(self->controls.value(PORT_ALGORITHM_TYPE))));
     }
-    apply(self->param1, &DisynEngine::setParam1);
-    apply(self->param2, &DisynEngine::setParam2);
-    apply(self->attack, &DisynEngine::setAttack);
-    apply(self->release, &DisynEngine::setRelease);
-    apply(self->reverbSize, &DisynEngine::setReverbSize);
-    apply(self->reverbLevel, &DisynEngine::setReverbLevel);
-    apply(self->masterGain, &DisynEngine::setMasterGain);
+    apply(PORT_PARAM_1, &DisynEngine::setParam1);
+    apply(PORT_PARAM_2, &DisynEngine::setParam2);
+    apply(PORT_ENVELOPE_ATTACK, &DisynEngine::setAttack);
+    apply(PORT_ENVELOPE_RELEASE, &DisynEngine::setRelease);
+    apply(PORT_REVERB_SIZE, &DisynEngine::setReverbSize);
+    apply(PORT_REVERB_LEVEL, &DisynEngine::setReverbLevel);
+    apply(PORT_MASTER_GAIN, &DisynEngine::setMasterGain);
+    apply(PORT_REVERB_MODE, &DisynEngine::setReverbMode);
 }
 
 static void handle_midi(DisynLV2* self, const uint8_t* msg, uint32_t size) {
@@ -134,15 +138,6 @@ static LV2_Handle instantiate(const LV2_Descriptor*, double rate,
     self->midiIn = nullptr;
     self->audioOut = nullptr;
 
-    self->algorithmType = nullptr;
-    self->param1 = nullptr;
-    self->param2 = nullptr;
-    self->attack = nullptr;
-    self->release = nullptr;
-    self->reverbSize = nullptr;
-    self->reverbLevel = nullptr;
-    self->masterGain = nullptr;
-
     self->map = nullptr;
     self->midiEventUrid = 0;
     self->currentNote = -1;
@@ -176,24 +171,16 @@ static void connect_port(LV2_Handle instance, uint32_t port, void* data) {
     switch (port) {
         case PORT_AUDIO_OUT: self->audioOut = static_cast<float*>(data); break;
         case PORT_MIDI_IN: self->midiIn = static_cast<const LV2_Atom_Sequence*>(data); break;
-        case PORT_ALGORITHM_TYPE: self->algorithmType = static_cast<const float*>(data); break;
-        case PORT_PARAM_1: self->param1 = static_cast<const float*>(data); break;
-        case PORT_PARAM_2: self->param2 = static_cast<const float*>(data); break;
-        case PORT_ENVELOPE_ATTACK: self->attack = static_cast<const float*>(data); break;
-        case PORT_ENVELOPE_RELEASE: self->release = static_cast<const float*>(data); break;
-        case PORT_REVERB_SIZE: self->reverbSize = static_cast<const float*>(data); break;
-        case PORT_REVERB_LEVEL: self->reverbLevel = static_cast<const float*>(data); break;
-        case PORT_MASTER_GAIN: self->masterGain = static_cast<const float*>(data); break;
-        default: break;
+        default: self->controls.connect(port, static_cast<const float*>(data)); break;
     }
 }
 
 static void activate(LV2_Handle instance) {
     auto* self = static_cast<flues::disyn::DisynLV2*>(instance);
-    if (!self) {
+    if (!self || !self->engine) {
         return;
     }
-    self->engine = std::make_unique<flues::disyn::DisynEngine>(self->sampleRate);
+    self->engine->resetAll();
     self->currentNote = -1;
 }
 
@@ -204,10 +191,11 @@ static void run(LV2_Handle instance, uint32_t n_samples) {
         return;
     }
 
+    const flues::pm::DenormalGuard denormalGuard;
+
     apply_parameters(self);
 
     float* out = self->audioOut;
-    std::memset(out, 0, n_samples * sizeof(float));
 
     uint32_t frame = 0;
 
@@ -219,9 +207,8 @@ static void run(LV2_Handle instance, uint32_t n_samples) {
 
             if (frame < eventFrame) {
                 const uint32_t limit = std::min(eventFrame, n_samples);
-                for (; frame < limit; ++frame) {
-                    out[frame] = self->engine->process();
-                }
+                self->engine->processBlock(out + frame, limit - frame);
+                frame = limit;
             }
 
             if (ev->body.type == self->midiEventUrid) {
@@ -231,8 +218,8 @@ static void run(LV2_Handle instance, uint32_t n_samples) {
         }
     }
 
-    for (; frame < n_samples; ++frame) {
-        out[frame] = self->engine->process();
+    if (frame < n_samples) {
+        self->engine->processBlock(out + frame, n_samples - frame);
     }
 }
 
@@ -2,10 +2,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+
+#include "../FastMath.hpp"
 
 namespace flues::disyn {
 
-const float TWO_PI = 2.0f * M_PI;
 const float EPSILON = 1e-8f;
 
 enum class AlgorithmType : int {
@@ -18,15 +20,18 @@ enum class AlgorithmType : int {
     MOD_FM = 6
 };
 
-// Parameter structures for each algorithm
+// Prepared parameters for each algorithm: param1/param2 mapped onto the
+// algorithm's ranges, plus anything derived from them alone.
 struct DirichletParams {
     float harmonics;  // 1-64
     float tilt;       // -3 to +15 dB/oct
+    float gain;       // tilt gain / harmonics
 };
 
 struct DSFParams {
-    float decay;  // 0-0.98 or 0-0.96
-    float ratio;  // 0.5-4 or 0.5-4.5
+    float decay;      // 0-0.98 or 0-0.96
+    float ratio;      // 0.5-4 or 0.5-4.5
+    float normalise;  // sqrt(1 - decay^2)
 };
 
 struct TanhParams {
@@ -37,6 +42,7 @@ struct TanhParams {
 struct PAFParams {
     float formant;    // 0.5-6 (×f0)
     float bandwidth;  // 50-3000 Hz
+    float decay;      // exp(-bandwidth / sampleRate)
 };
 
 struct ModFMParams {
@@ -44,74 +50,215 @@ struct ModFMParams {
     float ratio;  // 0.25-6
 };
 
+/**
+ * The seven Disyn algorithms. param1/param2 are mapped onto each
+ * algorithm's ranges only when they change, not per sample: they glide to
+ * new values over kSmoothingSeconds and the prepared parameters are
+ * recomputed during the glide only. Changing the algorithm jumps straight
+ * to the new mapping.
+ *
+ * processBlock() takes the algorithm switch once per block; process() is
+ * the same per-sample step, so the two render identically.
+ */
 class OscillatorModule {
 public:
+    static constexpr float kSmoothingSeconds = 0.005f;
+
     explicit OscillatorModule(float sampleRate = 44100.0f)
         : sampleRate(sampleRate),
+          inverseSampleRate(1.0f / sampleRate),
+          smoothing(1.0f - std::exp(-1.0f / (kSmoothingSeconds * sampleRate))),
+          algorithm(AlgorithmType::TANH_SQUARE),
+          targetParam1(0.5f),
+          targetParam2(0.5f),
+          param1(0.5f),
+          param2(0.5f),
+          settled(true),
           phase(0.0f),
           modPhase(0.0f),
           secondaryPhase(0.0f),
-          secondaryPhaseNeg(0.0f) {}
+          secondaryPhaseNeg(0.0f) {
+        prepare();
+    }
 
+    // Clears the phases and jumps to the target parameters.
     void reset() {
         phase = 0.0f;
         modPhase = 0.0f;
         secondaryPhase = 0.0f;
         secondaryPhaseNeg = 0.0f;
+        snapParameters();
+    }
+
+    void setParameters(AlgorithmType type, float value1, float value2) {
+        value1 = std::clamp(value1, 0.0f, 1.0f);
+        value2 = std::clamp(value2, 0.0f, 1.0f);
+        if (type != algorithm) {
+            algorithm = type;
+            targetParam1 = value1;
+            targetParam2 = value2;
+            snapParameters();
+        } else if (value1 != targetParam1 || value2 != targetParam2) {
+            targetParam1 = value1;
+            targetParam2 = value2;
+            settled = false;
+        }
+    }
+
+    // Main process function - one sample of the given algorithm
+    float process(AlgorithmType type, float value1, float value2, float frequency) {
+        float output;
+        processBlock(type, value1, value2, &frequency, &output, 1);
+        return output;
     }
 
-    // Main process function - dispatches to algorithm-specific methods
-    float process(AlgorithmType algorithm, float param1, float param2, float frequency) {
+    // Renders `frames` samples, with a per-sample frequency.
+    void processBlock(AlgorithmType type, float value1, float value2,
+                      const float* frequency, float* out, std::size_t frames) {
+        setParameters(type, value1, value2);
         switch (algorithm) {
             case AlgorithmType::DIRICHLET_PULSE:
-                return processDirichletPulse(param1, param2, frequency);
+                return render(frequency, out, frames, [this](float f) { return tickDirichletPulse(f); });
             case AlgorithmType::DSF_SINGLE:
-                return processDSF(param1, param2, frequency);
+                return render(frequency, out, frames, [this](float f) { return tickDSF(f); });
             case AlgorithmType::DSF_DOUBLE:
-                return processDSFDouble(param1, param2, frequency);
+                return render(frequency, out, frames, [this](float f) { return tickDSFDouble(f); });
             case AlgorithmType::TANH_SQUARE:
-                return processTanhSquare(param1, param2, frequency);
+                return render(frequency, out, frames, [this](float f) { return tickTanhSquare(f); });
             case AlgorithmType::TANH_SAW:
-                return processTanhSaw(param1, param2, frequency);
+                return render(frequency, out, frames, [this](float f) { return tickTanhSaw(f); });
             case AlgorithmType::PAF:
-                return processPAF(param1, param2, frequency);
+                return render(frequency, out, frames, [this](float f) { return tickPAF(f); });
             case AlgorithmType::MOD_FM:
-                return processModFM(param1, param2, frequency);
+                return render(frequency, out, frames, [this](float f) { return tickModFM(f); });
             default:
-                return processSine(frequency);
+                return render(frequency, out, frames, [this](float f) { return tickSine(f); });
         }
     }
 
 private:
     float sampleRate;
+    float inverseSampleRate;
+    float smoothing;
+    AlgorithmType algorithm;
+    float targetParam1;
+    float targetParam2;
+    float param1;
+    float param2;
+    bool settled;
+
+    DirichletParams dirichlet{};
+    DSFParams dsf{};
+    TanhParams tanhShape{};
+    PAFParams paf{};
+    ModFMParams modFM{};
+
     float phase;
     float modPhase;
     float secondaryPhase;
     float secondaryPhaseNeg;
 
-    // Helper: step phase accumulator forward by frequency
+    // The per-sample loop, instantiated once per algorithm. While the
+    // parameters glide they are re-prepared every sample; after that the
+    // prepared values are reused.
+    template <class Tick>
+    void render(const float* frequency, float* out, std::size_t frames, Tick tick) {
+        std::size_t i = 0;
+        for (; i < frames && !settled; ++i) {
+            glide();
+            out[i] = tick(frequency[i]);
+        }
+        for (; i < frames; ++i) {
+            out[i] = tick(frequency[i]);
+        }
+    }
+
+    void glide() {
+        param1 += (targetParam1 - param1) * smoothing;
+        param2 += (targetParam2 - param2) * smoothing;
+        if (std::abs(targetParam1 - param1) < 1e-5f && std::abs(targetParam2 - param2) < 1e-5f) {
+            param1 = targetParam1;
+            param2 = targetParam2;
+            settled = true;
+        }
+        prepare();
+    }
+
+    void snapParameters() {
+        param1 = targetParam1;
+        param2 = targetParam2;
+        settled = true;
+        prepare();
+    }
+
+    // Maps param1/param2 for the current algorithm only.
+    void prepare() {
+        switch (algorithm) {
+            case AlgorithmType::DIRICHLET_PULSE:
+                // param1=harmonics (1-64), param2=tilt (-3 to +15 dB/oct)
+                dirichlet.harmonics = std::max(1.0f, std::round(1.0f + param1 * 63.0f));
+                dirichlet.tilt = -3.0f + param2 * 18.0f;
+                dirichlet.gain = fastmath::dbToGain(dirichlet.tilt) / dirichlet.harmonics;
+                break;
+            case AlgorithmType::DSF_SINGLE:
+                // param1=decay (0-0.98), param2=ratio (0.5-4)
+                prepareDSF(std::min(param1 * 0.98f, 0.98f), expoMap(param2, 0.5f, 4.0f));
+                break;
+            case AlgorithmType::DSF_DOUBLE:
+                // param1=decay (0-0.96), param2=ratio (0.5-4.5)
+                prepareDSF(std::min(param1 * 0.96f, 0.96f), expoMap(param2, 0.5f, 4.5f));
+                break;
+            case AlgorithmType::TANH_SQUARE:
+                // param1=drive (0.05-5), param2=trim (0.2-1.2)
+                tanhShape.drive = expoMap(param1, 0.05f, 5.0f);
+                tanhShape.secondary = expoMap(param2, 0.2f, 1.2f);
+                break;
+            case AlgorithmType::TANH_SAW:
+                // param1=drive (0.05-4.5), param2=blend (0-1)
+                tanhShape.drive = expoMap(param1, 0.05f, 4.5f);
+                tanhShape.secondary = param2;
+                break;
+            case AlgorithmType::PAF:
+                // param1=formant (0.5-6 ×f0), param2=bandwidth (50-3000 Hz)
+                paf.formant = expoMap(param1, 0.5f, 6.0f);
+                paf.bandwidth = expoMap(param2, 50.0f, 3000.0f);
+                paf.decay = fastmath::exp(-paf.bandwidth / sampleRate);
+                break;
+            case AlgorithmType::MOD_FM:
+                // param1=index (0.01-8), param2=ratio (0.25-6)
+                modFM.index = expoMap(param1, 0.01f, 8.0f);
+                modFM.ratio = expoMap(param2, 0.25f, 6.0f);
+                break;
+            default:
+                break;
+        }
+    }
+
+    void prepareDSF(float decay, float ratio) {
+        dsf.decay = decay;
+        dsf.ratio = ratio;
+        dsf.normalise = std::sqrt(1.0f - decay * decay);
+    }
+
+    // Helper: step phase accumulator forward by frequency, wrapping into
+    // [0, 1] (rounding next - 0.5 is floor() without the libm call)
     float stepPhase(float currentPhase, float freq) {
-        float next = currentPhase + freq / sampleRate;
-        return next - std::floor(next);
+        const float next = currentPhase + freq * inverseSampleRate;
+        return next - fastmath::roundNearest(next - 0.5f);
     }
 
     // Fallback: simple sine wave
-    float processSine(float frequency) {
+    float tickSine(float frequency) {
         phase = stepPhase(phase, frequency);
-        return std::sin(phase * TWO_PI);
+        return fastmath::sin2pi(phase);
     }
 
     // Algorithm 1: Dirichlet Pulse (Band-Limited Pulse)
-    float processDirichletPulse(float param1, float param2, float frequency) {
-        // Map parameters: param1=harmonics (1-64), param2=tilt (-3 to +15 dB/oct)
-        const int harmonics = std::max(1, static_cast<int>(std::round(1.0f + param1 * 63.0f)));
-        const float tilt = -3.0f + param2 * 18.0f;
-
+    float tickDirichletPulse(float frequency) {
         phase = stepPhase(phase, frequency);
-        const float theta = phase * TWO_PI;
 
-        const float numerator = std::sin((2.0f * harmonics + 1.0f) * theta * 0.5f);
-        const float denominator = std::sin(theta * 0.5f);
+        const float numerator = fastmath::sin2pi((2.0f * dirichlet.harmonics + 1.0f) * phase * 0.5f);
+        const float denominator = fastmath::sin2pi(phase * 0.5f);
 
         float value;
         if (std::abs(denominator) < EPSILON) {
@@ -120,122 +267,91 @@ private:
             value = (numerator / denominator) - 1.0f;
         }
 
-        const float tiltFactor = std::pow(10.0f, tilt / 20.0f);
-        return (value / static_cast<float>(harmonics)) * tiltFactor;
+        return value * dirichlet.gain;
     }
 
     // Algorithm 2: Single-Sided DSF
-    float processDSF(float param1, float param2, float frequency) {
-        // Map parameters: param1=decay (0-0.98), param2=ratio (0.5-4)
-        const float decay = std::min(param1 * 0.98f, 0.98f);
-        const float ratio = expoMap(param2, 0.5f, 4.0f);
-
+    float tickDSF(float frequency) {
         phase = stepPhase(phase, frequency);
-        secondaryPhase = stepPhase(secondaryPhase, frequency * ratio);
-
-        const float w = phase * TWO_PI;
-        const float t = secondaryPhase * TWO_PI;
+        secondaryPhase = stepPhase(secondaryPhase, frequency * dsf.ratio);
 
-        return computeDSFComponent(w, t, decay);
+        return computeDSFComponent(phase, secondaryPhase);
     }
 
     // Algorithm 3: Double-Sided DSF
-    float processDSFDouble(float param1, float param2, float frequency) {
-        // Map parameters: param1=decay (0-0.96), param2=ratio (0.5-4.5)
-        const float decay = std::min(param1 * 0.96f, 0.96f);
-        const float ratio = expoMap(param2, 0.5f, 4.5f);
-
+    float tickDSFDouble(float frequency) {
         phase = stepPhase(phase, frequency);
-        secondaryPhase = stepPhase(secondaryPhase, frequency * ratio);
-        secondaryPhaseNeg = stepPhase(secondaryPhaseNeg, frequency * ratio);
-
-        const float w = phase * TWO_PI;
-        const float tPos = secondaryPhase * TWO_PI;
-        const float tNeg = -secondaryPhaseNeg * TWO_PI;
+        secondaryPhase = stepPhase(secondaryPhase, frequency * dsf.ratio);
+        secondaryPhaseNeg = stepPhase(secondaryPhaseNeg, frequency * dsf.ratio);
 
-        const float positive = computeDSFComponent(w, tPos, decay);
-        const float negative = computeDSFComponent(w, tNeg, decay);
+        const float positive = computeDSFComponent(phase, secondaryPhase);
+        const float negative = computeDSFComponent(phase, -secondaryPhaseNeg);
 
         return 0.5f * (positive + negative);
     }
 
-    // Helper: DSF computation (Moorer discrete summation formula)
-    float computeDSFComponent(float w, float t, float decay) {
-        const float denominator = 1.0f - 2.0f * decay * std::cos(t) + decay * decay;
+    // Helper: DSF computation (Moorer discrete summation formula); w and t
+    // are phases in cycles
+    float computeDSFComponent(float w, float t) {
+        const float decay = dsf.decay;
+        const float denominator = 1.0f - 2.0f * decay * fastmath::cos2pi(t) + decay * decay;
         if (std::abs(denominator) < EPSILON) {
             return 0.0f;
         }
 
-        const float numerator = std::sin(w) - decay * std::sin(w - t);
-        const float normalise = std::sqrt(1.0f - decay * decay);
-        return (numerator / denominator) * normalise;
+        const float numerator = fastmath::sin2pi(w) - decay * fastmath::sin2pi(w - t);
+        return (numerator / denominator) * dsf.normalise;
     }
 
     // Algorithm 4: Tanh Square (Hyperbolic Tangent Waveshaping)
-    float processTanhSquare(float param1, float param2, float frequency) {
-        // Map parameters: param1=drive (0.05-5), param2=trim (0.2-1.2)
-        const float drive = expoMap(param1, 0.05f, 5.0f);
-        const float trim = expoMap(param2, 0.2f, 1.2f);
-
+    float tickTanhSquare(float frequency) {
         phase = stepPhase(phase, frequency);
-        const float carrier = std::sin(phase * TWO_PI);
-        return std::tanh(carrier * drive) * trim;
+        const float carrier = fastmath::sin2pi(phase);
+        return fastmath::tanh(carrier * tanhShape.drive) * tanhShape.secondary;
     }
 
     // Algorithm 5: Tanh Saw (Square-to-Saw Transformation)
-    float processTanhSaw(float param1, float param2, float frequency) {
-        // Map parameters: param1=drive (0.05-4.5), param2=blend (0-1)
-        const float drive = expoMap(param1, 0.05f, 4.5f);
-        const float blend = std::clamp(param2, 0.0f, 1.0f);
+    float tickTanhSaw(float frequency) {
+        const float blend = tanhShape.secondary;
 
         phase = stepPhase(phase, frequency);
-        const float sine = std::sin(phase * TWO_PI);
-        const float square = std::tanh(sine * drive);
+        const float sine = fastmath::sin2pi(phase);
+        const float square = fastmath::tanh(sine * tanhShape.drive);
 
         secondaryPhase = stepPhase(secondaryPhase, frequency);
-        const float cosine = std::cos(secondaryPhase * TWO_PI);
+        const float cosine = fastmath::cos2pi(secondaryPhase);
         const float saw = square + cosine * (1.0f - square * square);
 
         return square * (1.0f - blend) + saw * blend;
     }
 
     // Algorithm 6: Phase-Aligned Formant (PAF)
-    float processPAF(float param1, float param2, float frequency) {
-        // Map parameters: param1=formant (0.5-6 ×f0), param2=bandwidth (50-3000 Hz)
-        const float ratio = expoMap(param1, 0.5f, 6.0f);
-        const float bandwidth = expoMap(param2, 50.0f, 3000.0f);
-
+    float tickPAF(float frequency) {
         phase = stepPhase(phase, frequency);
-        secondaryPhase = stepPhase(secondaryPhase, frequency * ratio);
+        secondaryPhase = stepPhase(secondaryPhase, frequency * paf.formant);
 
-        const float carrier = std::sin(secondaryPhase * TWO_PI);
-        const float mod = std::sin(phase * TWO_PI);
-        const float decay = std::exp(-bandwidth / sampleRate);
-        modPhase = decay * modPhase + (1.0f - decay) * mod;
+        const float carrier = fastmath::sin2pi(secondaryPhase);
+        const float mod = fastmath::sin2pi(phase);
+        modPhase = paf.decay * modPhase + (1.0f - paf.decay) * mod;
 
         return carrier * (0.6f + 0.4f * modPhase);
     }
 
     // Algorithm 7: Modified FM
-    float processModFM(float param1, float param2, float frequency) {
-        // Map parameters: param1=index (0.01-8), param2=ratio (0.25-6)
-        const float index = expoMap(param1, 0.01f, 8.0f);
-        const float ratio = expoMap(param2, 0.25f, 6.0f);
-
+    float tickModFM(float frequency) {
         phase = stepPhase(phase, frequency);
-        modPhase = stepPhase(modPhase, frequency * ratio);
+        modPhase = stepPhase(modPhase, frequency * modFM.ratio);
 
-        const float carrier = std::cos(phase * TWO_PI);
-        const float modulator = std::cos(modPhase * TWO_PI);
-        const float envelope = std::exp(-index);
+        const float carrier = fastmath::cos2pi(phase);
+        const float modulator = fastmath::cos2pi(modPhase);
 
-        return carrier * std::exp(index * (modulator - 1.0f)) * envelope;
+        // exp(-index) folded into the modulator exponent.
+        return carrier * fastmath::exp(modFM.index * (modulator - 2.0f));
     }
 
     // Helper: exponential mapping from normalized 0-1 to min-max range
     float expoMap(float value, float min, float max) {
-        const float clamped = std::clamp(value, 0.0f, 1.0f);
-        return min * std::pow(max / min, clamped);
+        return fastmath::expoMap(value, min, max);
     }
 };
 
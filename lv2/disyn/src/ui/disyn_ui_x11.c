@@ -14,7 +14,10 @@
 #include <string.h>
 #include <unistd.h>
 
+// Overridden at build time when this UI is reused by another bundle (disyn-poly).
+#ifndef DISYN_URI
 #define DISYN_URI "https://danja.github.io/flues/plugins/disyn"
+#endif
 #define DISYN_UI_URI DISYN_URI "#ui"
 #define LOG_PREFIX "[Disyn UI] "
 
@@ -41,6 +44,7 @@ typedef enum {
     PORT_REVERB_SIZE,
     PORT_REVERB_LEVEL,
     PORT_MASTER_GAIN,
+    PORT_REVERB_MODE,
     PORT_TOTAL_COUNT
 } PortIndex;
 
@@ -62,6 +66,11 @@ static const char* const kAlgorithmLabels[] = {
     "Modified FM"
 };
 
+static const char* const kReverbModeLabels[] = {
+    "Schroeder",
+    "FDN"
+};
+
 typedef struct {
     GroupIndex group;
     const char* label;
@@ -84,6 +93,7 @@ static const ControlDesc kControlInfo[] = {
 
     { GROUP_SPACE, "REVERB SIZE", PORT_REVERB_SIZE, 0.0f, 1.0f, 0.50f, 0, NULL, 0 },
     { GROUP_SPACE, "REVERB LEVEL", PORT_REVERB_LEVEL, 0.0f, 1.0f, 0.30f, 0, NULL, 0 },
+    { GROUP_SPACE, "REVERB MODE", PORT_REVERB_MODE, 0.0f, 1.0f, 0.0f, 2, kReverbModeLabels, 2 },
 
     { GROUP_OUTPUT, "MASTER", PORT_MASTER_GAIN, 0.0f, 1.0f, 0.80f, 0, NULL, 0 }
 };
@@ -96,7 +106,7 @@ typedef struct {
 static const GroupLayout kGroupLayout[GROUP_COUNT] = {
     [GROUP_ALGO] = { 0, 3 },
     [GROUP_ENVELOPE] = { 1, 2 },
-    [GROUP_SPACE] = { 1, 2 },
+    [GROUP_SPACE] = { 1, 3 },
     [GROUP_OUTPUT] = { 2, 1 }
 };
 
@@ -0,0 +1,85 @@
+// Accuracy check for FastMath.hpp: sweeps each function against libm,
+// evaluated in double at the same float input, and exits 1 if any of them
+// reaches the error bound documented in the header.
+
+#include <cmath>
+#include <cstdio>
+
+#include "../src/FastMath.hpp"
+
+namespace {
+
+namespace fm = flues::disyn::fastmath;
+
+constexpr double kTwoPi = 6.283185307179586;
+
+// Points per sweep. Dense enough to land on every segment of the
+// polynomials and the range reduction, quick enough to run on each build.
+constexpr int kSweepPoints = 1 << 21;
+
+struct Sweep {
+    const char* name;
+    double lo;
+    double hi;
+    bool relative;
+    double bound;
+    float (*fast)(float);
+    double (*reference)(double);
+};
+
+const Sweep kSweeps[] = {
+    {"sin2pi", -63.999, 63.999, false, 5e-7,
+     fm::sin2pi, [](double x) { return std::sin(kTwoPi * x); }},
+    {"cos2pi", -63.999, 63.999, false, 5e-7,
+     fm::cos2pi, [](double x) { return std::cos(kTwoPi * x); }},
+    {"exp2", -126.0, 126.0, true, 6e-7,
+     fm::exp2, [](double x) { return std::exp2(x); }},
+    {"exp", -15.999, 15.999, true, 2e-6,
+     fm::exp, [](double x) { return std::exp(x); }},
+    {"tanh", -20.0, 20.0, false, 5e-7,
+     fm::tanh, [](double x) { return std::tanh(x); }},
+};
+
+double maxError(const Sweep& sweep, double& worstInput) {
+    double worst = 0.0;
+    worstInput = sweep.lo;
+    for (int i = 0; i <= kSweepPoints; ++i) {
+        const float x = static_cast<float>(sweep.lo + (sweep.hi - sweep.lo) * i / kSweepPoints);
+        const double expected = sweep.reference(x);
+        double error = std::abs(static_cast<double>(sweep.fast(x)) - expected);
+        if (sweep.relative) {
+            error /= std::abs(expected);
+        }
+        if (!(error <= worst)) {
+            worst = error;
+            worstInput = x;
+        }
+    }
+    return worst;
+}
+
+} // namespace
+
+int main() {
+    int failures = 0;
+    std::printf("%-8s %-20s %-4s %12s %12s %12s\n",
+                "function", "range", "err", "max error", "at", "bound");
+    for (const Sweep& sweep : kSweeps) {
+        double worstInput = 0.0;
+        const double worst = maxError(sweep, worstInput);
+        const bool failed = !(worst < sweep.bound);
+        failures += failed ? 1 : 0;
+
+        char range[32];
+        std::snprintf(range, sizeof(range), "[%g, %g]", sweep.lo, sweep.hi);
+        std::printf("%-8s %-20s %-4s %12.3g %12.6g %12.3g%s\n",
+                    sweep.name, range, sweep.relative ? "rel" : "abs",
+                    worst, worstInput, sweep.bound, failed ? "  FAIL" : "");
+    }
+
+    if (failures > 0) {
+        std::printf("%d function(s) exceed their error bound\n", failures);
+        return 1;
+    }
+    return 0;
+}
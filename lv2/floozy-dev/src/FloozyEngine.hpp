@@ -4,11 +4,13 @@
 #include <array>
 #include <cmath>
 #include <cstdint>
-#include <limits>
-#include <memory>
+#include <utility>
 
 #include "modules/FloozySourceModule.hpp"
 
+#include "../../pm-synth/src/DenormalGuard.hpp"
+#include "../../pm-synth/src/Profiler.hpp"
+#include "../../pm-synth/src/VoiceAllocator.hpp"
 #include "../../pm-synth/src/modules/DelayLinesModule.hpp"
 #include "../../pm-synth/src/modules/EnvelopeModule.hpp"
 #include "../../pm-synth/src/modules/FeedbackModule.hpp"
@@ -76,8 +78,7 @@ public:
           prevFilterOutput_(0.0f),
           postReleaseDamp_(1.0f),
           paramsVersion_(0),
-          ageCounter_(0),
-          lastOutput_(0.0f) {}
+          ageCounter_(0) {}
 
     void noteOn(int midiNote, float frequency, const FloozyParams& params, uint64_t age) {
         midiNote_ = midiNote;
@@ -117,23 +118,39 @@ public:
         dcBlockerY1_ = 0.0f;
         prevDelayOutputs_ = {0.0f, 0.0f};
         prevFilterOutput_ = 0.0f;
-        lastOutput_ = 0.0f;
+    }
+
+    void seed(uint32_t value) {
+        using flues::pm::Random;
+        source_.seed(Random::deriveSeed(value, 0));
+        delayLines_.seed(Random::deriveSeed(value, 1));
+        interfaceModule_.seed(Random::deriveSeed(value, 2));
+    }
+
+    // forceStop() with every pooled interface strategy cleared as well.
+    void resetAll() {
+        forceStop();
+        interfaceModule_.resetAll();
+        paramsVersion_ = 0;
     }
 
     float process(const FloozyParams& params) {
         if (!active_) {
-            lastOutput_ = 0.0f;
             return 0.0f;
         }
 
         syncParams(params);
 
+        FLUES_PROFILE_LAP_BEGIN(*profiler_);
         const flues::pm::ModulationState modState = modulation_.process();
         const float modulatedFrequency = frequency_ * modState.fm;
+        FLUES_PROFILE_LAP(Modulation);
         const float sourceSignal = source_.process(modulatedFrequency);
+        FLUES_PROFILE_LAP(Source);
         const float env = envelope_.process();
         const bool envActive = envelope_.isPlaying();
         const float envelopedSignal = sourceSignal * env;
+        FLUES_PROFILE_LAP(Envelope);
 
         const float feedbackSignal = feedback_.process(
             prevDelayOutputs_.delay1,
@@ -143,24 +160,27 @@ public:
         if (envActive) {
             postReleaseDamp_ = 1.0f;
         } else {
-            postReleaseDamp_ *= 0.995f;
+            postReleaseDamp_ = flues::pm::flushDenormal(postReleaseDamp_ * 0.995f);
         }
 
         const float cleanFeedback = dcBlock(feedbackSignal) * postReleaseDamp_;
         const float interfaceInput = envelopedSignal + cleanFeedback;
         const float interfaceOutput = interfaceModule_.process(interfaceInput);
         const float clampedDelayInput = std::clamp(interfaceOutput, -1.0f, 1.0f);
+        FLUES_PROFILE_LAP(Interface);
 
         const auto delayOutputs = delayLines_.process(clampedDelayInput, frequency_);
+        FLUES_PROFILE_LAP(DelayLines);
         const float delayMix = (delayOutputs.delay1 + delayOutputs.delay2) * 0.5f;
         const float filterOutput = filter_.process(delayMix);
+        FLUES_PROFILE_LAP(Filter);
         const float preReverb = filterOutput * modState.am * params.masterGain;
 
         prevDelayOutputs_ = delayOutputs;
         prevFilterOutput_ = filterOutput;
 
-        lastOutput_ = preReverb;
-
+        // Release detection: the engine drops the voice from its active
+        // set as soon as this stops it.
         if (!envActive &&
             postReleaseDamp_ < 1e-4f &&
             std::fabs(preReverb) < 1e-5f &&
@@ -176,7 +196,10 @@ public:
     bool isReleasing() const { return releasing_; }
     int note() const { return midiNote_; }
     uint64_t age() const { return ageCounter_; }
-    float level() const { return std::fabs(lastOutput_); }
+
+#if defined(FLUES_PROFILE)
+    void setProfiler(flues::pm::Profiler* profiler) { profiler_ = profiler; }
+#endif
 
 private:
     void syncParams(const FloozyParams& params) {
@@ -198,8 +221,7 @@ private:
         interfaceModule_.setType(static_cast<int>(std::round(params.interfaceType)));
         interfaceModule_.setIntensity(params.interfaceIntensity);
 
-        delayLines_.setTuning(params.tuning);
-        delayLines_.setRatio(params.ratio);
+        delayLines_.setTuningAndRatio(params.tuning, params.ratio);
 
         feedback_.setDelay1Gain(params.delay1Feedback);
         feedback_.setDelay2Gain(params.delay2Feedback);
@@ -226,14 +248,13 @@ private:
         prevDelayOutputs_ = {0.0f, 0.0f};
         prevFilterOutput_ = 0.0f;
         postReleaseDamp_ = 1.0f;
-        lastOutput_ = 0.0f;
         paramsVersion_ = 0;
     }
 
     float dcBlock(float sample) {
         const float y = sample - dcBlockerX1_ + 0.995f * dcBlockerY1_;
         dcBlockerX1_ = sample;
-        dcBlockerY1_ = y;
+        dcBlockerY1_ = flues::pm::flushDenormal(y);
         return y;
     }
 
@@ -256,20 +277,34 @@ private:
     float postReleaseDamp_;
     uint64_t paramsVersion_;
     uint64_t ageCounter_;
-    float lastOutput_;
+
+#if defined(FLUES_PROFILE)
+    flues::pm::Profiler* profiler_ = nullptr;
+#endif
 };
 
+// Voice count of the engine, at most 64.
+#ifndef FLOOZY_DEV_MAX_VOICES
+#define FLOOZY_DEV_MAX_VOICES 8
+#endif
+
 class FloozyPolyEngine {
 public:
-    static constexpr size_t kMaxVoices = 8;
+    static constexpr size_t kMaxVoices = FLOOZY_DEV_MAX_VOICES;
+    static_assert(kMaxVoices >= 1 && kMaxVoices <= 64, "the voice allocator tracks 1 to 64 voices");
 
     explicit FloozyPolyEngine(float sampleRate = 44100.0f)
         : sampleRate_(sampleRate),
+          voices_(makeVoices(sampleRate, std::make_index_sequence<kMaxVoices>{})),
           reverb_(sampleRate),
-          voiceAgeCounter_(0) {
+          voiceAgeCounter_(0),
+          noiseSeed_(flues::pm::Random::nextDefaultSeed()) {
+#if defined(FLUES_PROFILE)
         for (auto& voice : voices_) {
-            voice = std::make_unique<FloozyVoice>(sampleRate_);
+            voice.setProfiler(&profiler_);
         }
+#endif
+        seed(noiseSeed_);
         reverb_.setSize(params_.reverbSize);
         reverb_.setLevel(params_.reverbLevel);
     }
@@ -310,46 +345,75 @@ public:
             reverb_.setLevel(clamped);
         }
     }
+    void setReverbMode(float value) { reverb_.setMode(static_cast<int>(std::round(value))); }
     void setMasterGain(float value) { setAndBump(params_.masterGain, std::clamp(value, 0.0f, 1.0f)); }
 
+    // Same policy as floozy-poly: retrigger, lowest idle voice, earliest
+    // released voice, oldest held voice.
     void noteOn(int midiNote, float frequency) {
-        if (auto* existing = findVoiceByNote(midiNote)) {
-            existing->noteOn(midiNote, frequency, params_, ++voiceAgeCounter_);
+        if (!VoiceAllocator::isValidNote(midiNote)) {
             return;
         }
-
-        if (auto* idle = findIdleVoice()) {
-            idle->noteOn(midiNote, frequency, params_, ++voiceAgeCounter_);
-            return;
-        }
-
-        auto* victim = selectVoiceToSteal();
-        if (victim) {
-            victim->noteOn(midiNote, frequency, params_, ++voiceAgeCounter_);
-        }
+        voices_[allocator_.noteOn(midiNote)].noteOn(midiNote, frequency, params_, ++voiceAgeCounter_);
     }
 
     void noteOff(int midiNote) {
-        if (auto* voice = findVoiceByNote(midiNote)) {
-            voice->noteOff();
+        const int slot = allocator_.noteOff(midiNote);
+        if (slot != VoiceAllocator::kNoVoice) {
+            voices_[static_cast<size_t>(slot)].noteOff();
         }
     }
 
     void allNotesOff() {
         for (auto& voice : voices_) {
-            voice->forceStop();
+            voice.forceStop();
         }
+        allocator_.reset(kMaxVoices);
         reverb_.reset();
     }
 
+    // allNotesOff() plus every voice's interface pool, the voice ages and
+    // the noise seeds, parameters kept. Allocation-free, for activate().
+    void resetAll() {
+        allNotesOff();
+        for (auto& voice : voices_) {
+            voice.resetAll();
+        }
+        voiceAgeCounter_ = 0;
+        seed(noiseSeed_);
+    }
+
+    // Reseeds every voice's noise sources so renders are reproducible.
+    void seed(uint32_t value) {
+        noiseSeed_ = value;
+        for (size_t i = 0; i < kMaxVoices; ++i) {
+            voices_[i].seed(flues::pm::Random::deriveSeed(value, static_cast<uint32_t>(i)));
+        }
+    }
+
     float process() {
         float accum = 0.0f;
-        for (auto& voice : voices_) {
-            accum += voice->process(params_);
+        // Only the sounding voices, in slot order: one held note costs one
+        // voice whatever the voice count.
+        for (uint64_t active = allocator_.activeMask(); active != 0; active &= active - 1) {
+            const size_t slot = static_cast<size_t>(__builtin_ctzll(active));
+            FloozyVoice& voice = voices_[slot];
+            accum += voice.process(params_);
+            if (!voice.isActive()) {
+                allocator_.voiceStopped(slot);
+            }
         }
+        FLUES_PROFILE_SCOPE(profiler_, Reverb);
         return reverb_.process(accum);
     }
 
+#if defined(FLUES_PROFILE)
+    // Stage timings of process(), summed over the voices. process() runs
+    // per sample, so the caller brackets each host block with
+    // FLUES_PROFILE_BEGIN_BLOCK/END_BLOCK on this profiler.
+    flues::pm::Profiler& profiler() { return profiler_; }
+#endif
+
 private:
     void setAndBump(float& target, float value) {
         if (target == value) {
@@ -359,54 +423,31 @@ private:
         params_.bump();
     }
 
-    FloozyVoice* findVoiceByNote(int midiNote) {
-        for (auto& voice : voices_) {
-            if (voice->isActive() && voice->note() == midiNote) {
-                return voice.get();
-            }
-        }
-        return nullptr;
-    }
+    using VoiceAllocator = flues::pm::VoiceAllocator<kMaxVoices>;
+    using VoiceArray = std::array<FloozyVoice, kMaxVoices>;
 
-    FloozyVoice* findIdleVoice() {
-        for (auto& voice : voices_) {
-            if (!voice->isActive()) {
-                return voice.get();
-            }
-        }
-        return nullptr;
+    // FloozyVoice can be neither copied nor moved, so the array is built in
+    // place from prvalues.
+    static FloozyVoice makeVoice(float sampleRate, size_t) {
+        return FloozyVoice(sampleRate);
     }
 
-    FloozyVoice* selectVoiceToSteal() {
-        FloozyVoice* candidate = nullptr;
-        uint64_t oldestAge = std::numeric_limits<uint64_t>::max();
-
-        for (auto& voice : voices_) {
-            if (voice->isReleasing() && voice->age() < oldestAge) {
-                candidate = voice.get();
-                oldestAge = voice->age();
-            }
-        }
-
-        if (candidate) {
-            return candidate;
-        }
-
-        float lowestLevel = std::numeric_limits<float>::max();
-        for (auto& voice : voices_) {
-            if (voice->level() < lowestLevel) {
-                lowestLevel = voice->level();
-                candidate = voice.get();
-            }
-        }
-        return candidate;
+    template <size_t... Slots>
+    static VoiceArray makeVoices(float sampleRate, std::index_sequence<Slots...>) {
+        return VoiceArray{{makeVoice(sampleRate, Slots)...}};
     }
 
     float sampleRate_;
     FloozyParams params_;
-    std::array<std::unique_ptr<FloozyVoice>, kMaxVoices> voices_;
+    VoiceArray voices_;
+    VoiceAllocator allocator_;
     flues::pm::ReverbModule reverb_;
     uint64_t voiceAgeCounter_;
+    uint32_t noiseSeed_;
+
+#if defined(FLUES_PROFILE)
+    flues::pm::Profiler profiler_;
+#endif
 };
 
 } // namespace flues::floozy_dev
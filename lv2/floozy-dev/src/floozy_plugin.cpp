@@ -11,6 +11,8 @@
 #include <lv2/urid/urid.h>
 
 #include "FloozyEngine.hpp"
+#include "../../pm-synth/src/DenormalGuard.hpp"
+#include "../../pm-synth/src/PortCache.hpp"
 
 #define FLOOZY_URI "https://danja.github.io/flues/plugins/floozy-dev"
 #define LOG_PREFIX "[Floozy Dev Plugin] "
@@ -43,9 +45,12 @@ enum PortIndex : uint32_t {
     PORT_REVERB_SIZE,
     PORT_REVERB_LEVEL,
     PORT_MASTER_GAIN,
+    PORT_REVERB_MODE,
     PORT_TOTAL_COUNT
 };
 
+using ControlPorts = flues::pm::PortCache<PORT_TOTAL_COUNT>;
+
 struct FloozyDevLV2 {
     std::unique_ptr<FloozyPolyEngine> engine;
     float sampleRate;
@@ -53,29 +58,7 @@ struct FloozyDevLV2 {
     const LV2_Atom_Sequence* midiIn;
     float* audioOut;
 
-    const float* sourceAlgorithm;
-    const float* sourceParam1;
-    const float* sourceParam2;
-    const float* sourceLevel;
-    const float* sourceNoise;
-    const float* sourceDC;
-    const float* envelopeAttack;
-    const float* envelopeRelease;
-    const float* interfaceType;
-    const float* interfaceIntensity;
-    const float* tuning;
-    const float* ratio;
-    const float* delay1Feedback;
-    const float* delay2Feedback;
-    const float* filterFeedback;
-    const float* filterFrequency;
-    const float* filterQ;
-    const float* filterShape;
-    const float* lfoFrequency;
-    const float* modulationTypeLevel;
-    const float* reverbSize;
-    const float* reverbLevel;
-    const float* masterGain;
+    ControlPorts controls;
 
     LV2_URID_Map* map;
     LV2_URID midiEventUrid;
@@ -87,39 +70,43 @@ static void apply_parameters(FloozyDevLV2* self) {
         return;
     }
 
-    auto apply = [&](const float* port, auto setter) {
-        if (port) {
-            (self->engine.get()->*setter)(*port);
+    const ControlPorts::Mask dirty = self->controls.poll();
+    if (!dirty) {
+        return;
+    }
+
+    auto apply = [&](uint32_t port, auto setter) {
+        if (dirty & ControlPorts::bit(port)) {
+            (self->engine.get()->*setter)(self->controls.value(port));
         }
     };
 
-    apply(self->sourceAlgorithm, &FloozyPolyEngine::setAlgorithm);
-    apply(self->sourceParam1, &FloozyPolyEngine::setParam1);
-    apply(self->sourceParam2, &FloozyPolyEngine::setParam2);
-    apply(self->sourceLevel, &FloozyPolyEngine::setToneLevel);
-    apply(self->sourceNoise, &FloozyPolyEngine::setNoiseLevel);
-    apply(self->sourceDC, &FloozyPolyEngine::setDCLevel);
-    apply(self->envelopeAttack, &FloozyPolyEngine::setAttack);
-    apply(self->envelopeRelease, &FloozyPolyEngine::setRelease);
-
-    if (self->interfaceType) {
-        self->engine->setInterfaceType(*self->interfaceType);
-    }
-
-    apply(self->interfaceIntensity, &FloozyPolyEngine::setInterfaceIntensity);
-    apply(self->tuning, &FloozyPolyEngine::setTuning);
-    apply(self->ratio, &FloozyPolyEngine::setRatio);
-    apply(self->delay1Feedback, &FloozyPolyEngine::setDelay1Feedback);
-    apply(self->delay2Feedback, &FloozyPolyEngine::setDelay2Feedback);
-    apply(self->filterFeedback, &FloozyPolyEngine::setFilterFeedback);
-    apply(self->filterFrequency, &FloozyPolyEngine::setFilterFrequency);
-    apply(self->filterQ, &FloozyPolyEngine::setFilterQ);
-    apply(self->filterShape, &FloozyPolyEngine::setFilterShape);
-    apply(self->lfoFrequency, &FloozyPolyEngine::setLFOFrequency);
-    apply(self->modulationTypeLevel, &FloozyPolyEngine::setModulationTypeLevel);
-    apply(self->reverbSize, &FloozyPolyEngine::setReverbSize);
-    apply(self->reverbLevel, &FloozyPolyEngine::setReverbLevel);
-    apply(self->masterGain, &FloozyPolyEngine::setMasterGain);
+    apply(PORT_SOURCE_ALGORITHM, &FloozyPolyEngine::setAlgorithm);
+    apply(PORT_SOURCE_PARAM1, &FloozyPolyEngine::setParam1);
+    apply(PORT_SOURCE_PARAM2, &FloozyPolyEngine::setParam2);
+    apply(PORT_SOURCE_LEVEL, &FloozyPolyEngine::setToneLevel);
+    apply(PORT_SOURCE_NOISE, &FloozyPolyEngine::setNoiseLevel);
+    apply(PORT_SOURCE_DC, &FloozyPolyEngine::setDCLevel);
+    apply(PORT_ENVELOPE_ATTACK, &FloozyPolyEngine::setAttack);
+    apply(PORT_ENVELOPE_RELEASE, &FloozyPolyEngine::setRelease);
+
+    apply(PORT_INTERFACE_TYPE, &FloozyPolyEngine::setInterfaceType);
+
+    apply(PORT_INTERFACE_INTENSITY, &FloozyPolyEngine::setInterfaceIntensity);
+    apply(PORT_TUNING, &FloozyPolyEngine::setTuning);
+    apply(PORT_RATIO, &FloozyPolyEngine::setRatio);
+    apply(PORT_DELAY1_FEEDBACK, &FloozyPolyEngine::setDelay1Feedback);
+    apply(PORT_DELAY2_FEEDBACK, &FloozyPolyEngine::setDelay2Feedback);
+    apply(PORT_FILTER_FEEDBACK, &FloozyPolyEngine::setFilterFeedback);
+    apply(PORT_FILTER_FREQUENCY, &FloozyPolyEngine::setFilterFrequency);
+    apply(PORT_FILTER_Q, &FloozyPolyEngine::setFilterQ);
+    apply(PORT_FILTER_SHAPE, &FloozyPolyEngine::setFilterShape);
+    apply(PORT_LFO_FREQUENCY, &FloozyPolyEngine::setLFOFrequency);
+    apply(PORT_MOD_TYPE_LEVEL, &FloozyPolyEngine::setModulationTypeLevel);
+    apply(PORT_REVERB_SIZE, &FloozyPolyEngine::setReverbSize);
+    apply(PORT_REVERB_LEVEL, &FloozyPolyEngine::setReverbLevel);
+    apply(PORT_MASTER_GAIN, &FloozyPolyEngine::setMasterGain);
+    apply(PORT_REVERB_MODE, &FloozyPolyEngine::setReverbMode);
 }
 
 static void handle_midi(FloozyDevLV2* self, const uint8_t* msg, uint32_t size) {
@@ -171,30 +158,6 @@ static LV2_Handle instantiate(const LV2_Descriptor*, double rate,
     self->midiIn = nullptr;
     self->audioOut = nullptr;
 
-    self->sourceAlgorithm = nullptr;
-    self->sourceParam1 = nullptr;
-    self->sourceParam2 = nullptr;
-    self->sourceLevel = nullptr;
-    self->sourceNoise = nullptr;
-    self->sourceDC = nullptr;
-    self->envelopeAttack = nullptr;
-    self->envelopeRelease = nullptr;
-    self->interfaceType = nullptr;
-    self->interfaceIntensity = nullptr;
-    self->tuning = nullptr;
-    self->ratio = nullptr;
-    self->delay1Feedback = nullptr;
-    self->delay2Feedback = nullptr;
-    self->filterFeedback = nullptr;
-    self->filterFrequency = nullptr;
-    self->filterQ = nullptr;
-    self->filterShape = nullptr;
-    self->lfoFrequency = nullptr;
-    self->modulationTypeLevel = nullptr;
-    self->reverbSize = nullptr;
-    self->reverbLevel = nullptr;
-    self->masterGain = nullptr;
-
     self->map = nullptr;
     self->midiEventUrid = 0;
     self->atomSequenceUrid = 0;
@@ -227,34 +190,17 @@ static void connect_port(LV2_Handle instance, uint32_t port, void* data) {
     switch (port) {
         case PORT_AUDIO_OUT: self->audioOut = static_cast<float*>(data); break;
         case PORT_MIDI_IN: self->midiIn = static_cast<const LV2_Atom_Sequence*>(data); break;
-        case PORT_SOURCE_ALGORITHM: self->sourceAlgorithm = static_cast<const float*>(data); break;
-        case PORT_SOURCE_PARAM1: self->sourceParam1 = static_cast<const float*>(data); break;
-        case PORT_SOURCE_PARAM2: self->sourceParam2 = static_cast<const float*>(data); break;
-        case PORT_SOURCE_LEVEL: self->sourceLevel = static_cast<const float*>(data); break;
-        case PORT_SOURCE_NOISE: self->sourceNoise = static_cast<const float*>(data); break;
-        case PORT_SOURCE_DC: self->sourceDC = static_cast<const float*>(data); break;
-        case PORT_ENVELOPE_ATTACK: self->envelopeAttack = static_cast<const float*>(data); break;
-        case PORT_ENVELOPE_RELEASE: self->envelopeRelease = static_cast<const float*>(data); break;
-        case PORT_INTERFACE_TYPE: self->interfaceType = static_cast<const float*>(data); break;
-        case PORT_INTERFACE_INTENSITY: self->interfaceIntensity = static_cast<const float*>(data); break;
-        case PORT_TUNING: self->tuning = static_cast<const float*>(data); break;
-        case PORT_RATIO: self->ratio = static_cast<const float*>(data); break;
-        case PORT_DELAY1_FEEDBACK: self->delay1Feedback = static_cast<const float*>(data); break;
-        case PORT_DELAY2_FEEDBACK: self->delay2Feedback = static_cast<const float*>(data); break;
-        case PORT_FILTER_FEEDBACK: self->filterFeedback = static_cast<const float*>(data); break;
-        case PORT_FILTER_FREQUENCY: self->filterFrequency = static_cast<const float*>(data); break;
-        case PORT_FILTER_Q: self->filterQ = static_cast<const float*>(data); break;
-        case PORT_FILTER_SHAPE: self->filterShape = static_cast<const float*>(data); break;
-        case PORT_LFO_FREQUENCY: self->lfoFrequency = static_cast<const float*>(data); break;
-        case PORT_MOD_TYPE_LEVEL: self->modulationTypeLevel = static_cast<const float*>(data); break;
-        case PORT_REVERB_SIZE: self->reverbSize = static_cast<const float*>(data); break;
-        case PORT_REVERB_LEVEL: self->reverbLevel = static_cast<const float*>(data); break;
-        case PORT_MASTER_GAIN: self->masterGain = static_cast<const float*>(data); break;
-        default: break;
+        default: self->controls.connect(port, static_cast<const float*>(data)); break;
     }
 }
 
-static void activate(LV2_Handle) {}
+static void activate(LV2_Handle instance) {
+    auto* self = static_cast<flues::floozy_dev::FloozyDevLV2*>(instance);
+    if (!self || !self->engine) {
+        return;
+    }
+    self->engine->resetAll();
+}
 
 static void run(LV2_Handle instance, uint32_t n_samples) {
     using namespace flues::floozy_dev;
@@ -263,12 +209,15 @@ static void run(LV2_Handle instance, uint32_t n_samples) {
         return;
     }
 
+    const flues::pm::DenormalGuard denormalGuard;
+
     apply_parameters(self);
 
     float* out = self->audioOut;
     std::memset(out, 0, n_samples * sizeof(float));
 
     uint32_t frame = 0;
+    FLUES_PROFILE_BEGIN_BLOCK(self->engine->profiler(), n_samples);
 
     if (self->midiIn && self->midiIn->atom.type == self->atomSequenceUrid) {
         LV2_ATOM_SEQUENCE_FOREACH(self->midiIn, ev) {
@@ -293,6 +242,7 @@ static void run(LV2_Handle instance, uint32_t n_samples) {
     for (; frame < n_samples; ++frame) {
         out[frame] = self->engine->process();
     }
+    FLUES_PROFILE_END_BLOCK(self->engine->profiler());
 }
 
 static void deactivate(LV2_Handle) {}
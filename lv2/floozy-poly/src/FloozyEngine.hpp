@@ -4,11 +4,14 @@
 #include <array>
 #include <cmath>
 #include <cstdint>
-#include <limits>
 #include <memory>
+#include <utility>
 
+#include "FloozyVoiceBank.hpp"
+#include "RenderWorkerPool.hpp"
 #include "modules/FloozySourceModule.hpp"
 
+#include "../../pm-synth/src/VoiceAllocator.hpp"
 #include "../../pm-synth/src/modules/DelayLinesModule.hpp"
 #include "../../pm-synth/src/modules/EnvelopeModule.hpp"
 #include "../../pm-synth/src/modules/FeedbackModule.hpp"
@@ -56,28 +59,22 @@ struct FloozyParams {
     void bump() { ++version; }
 };
 
+// Per-voice state that cannot be vectorised across voices: the source and
+// interface branch on algorithm/type and the delay lines have per-voice
+// lengths. Everything else lives in the engine's VoiceLaneGroup.
 class FloozyVoice {
 public:
-    explicit FloozyVoice(float sampleRate = 44100.0f)
+    explicit FloozyVoice(float sampleRate = 44100.0f, std::size_t slot = 0)
         : source_(sampleRate),
-          envelope_(sampleRate),
           interfaceModule_(sampleRate),
           delayLines_(sampleRate),
-          feedback_(),
-          filter_(sampleRate),
-          modulation_(sampleRate),
           frequency_(440.0f),
           active_(false),
           releasing_(false),
           midiNote_(-1),
-          dcBlockerX1_(0.0f),
-          dcBlockerY1_(0.0f),
-          prevDelayOutputs_{0.0f, 0.0f},
-          prevFilterOutput_(0.0f),
-          postReleaseDamp_(1.0f),
           paramsVersion_(0),
           ageCounter_(0),
-          lastOutput_(0.0f) {}
+          slot_(slot) {}
 
     void noteOn(int midiNote, float frequency, const FloozyParams& params, uint64_t age) {
         midiNote_ = midiNote;
@@ -88,7 +85,6 @@ public:
 
         resetModules();
         interfaceModule_.setGate(true);
-        envelope_.setGate(true);
         syncParams(params);
     }
 
@@ -97,7 +93,6 @@ public:
             return;
         }
         releasing_ = true;
-        envelope_.setGate(false);
         interfaceModule_.setGate(false);
     }
 
@@ -105,80 +100,26 @@ public:
         active_ = false;
         releasing_ = false;
         midiNote_ = -1;
-        envelope_.reset();
         interfaceModule_.reset();
         interfaceModule_.setGate(false);
         delayLines_.reset();
-        feedback_.reset();
-        filter_.reset();
-        modulation_.reset();
         source_.reset();
-        dcBlockerX1_ = 0.0f;
-        dcBlockerY1_ = 0.0f;
-        prevDelayOutputs_ = {0.0f, 0.0f};
-        prevFilterOutput_ = 0.0f;
-        lastOutput_ = 0.0f;
     }
 
-    float process(const FloozyParams& params) {
-        if (!active_) {
-            lastOutput_ = 0.0f;
-            return 0.0f;
-        }
-
-        syncParams(params);
-
-        const flues::pm::ModulationState modState = modulation_.process();
-        const float modulatedFrequency = frequency_ * modState.fm;
-        const float sourceSignal = source_.process(modulatedFrequency);
-        const float env = envelope_.process();
-        const bool envActive = envelope_.isPlaying();
-        const float envelopedSignal = sourceSignal * env;
-
-        const float feedbackSignal = feedback_.process(
-            prevDelayOutputs_.delay1,
-            prevDelayOutputs_.delay2,
-            prevFilterOutput_);
-
-        if (envActive) {
-            postReleaseDamp_ = 1.0f;
-        } else {
-            postReleaseDamp_ *= 0.995f;
-        }
-
-        const float cleanFeedback = dcBlock(feedbackSignal) * postReleaseDamp_;
-        const float interfaceInput = envelopedSignal + cleanFeedback;
-        const float interfaceOutput = interfaceModule_.process(interfaceInput);
-        const float clampedDelayInput = std::clamp(interfaceOutput, -1.0f, 1.0f);
-
-        const auto delayOutputs = delayLines_.process(clampedDelayInput, frequency_);
-        const float delayMix = (delayOutputs.delay1 + delayOutputs.delay2) * 0.5f;
-        const float filterOutput = filter_.process(delayMix);
-        const float preReverb = filterOutput * modState.am * params.masterGain;
-
-        prevDelayOutputs_ = delayOutputs;
-        prevFilterOutput_ = filterOutput;
-
-        lastOutput_ = preReverb;
-
-        if (!envActive &&
-            postReleaseDamp_ < 1e-4f &&
-            std::fabs(preReverb) < 1e-5f &&
-            std::fabs(prevDelayOutputs_.delay1) < 1e-5f &&
-            std::fabs(prevDelayOutputs_.delay2) < 1e-5f) {
-            forceStop();
-        }
-
-        return preReverb;
+    // forceStop() with every pooled interface strategy cleared as well.
+    void resetAll() {
+        forceStop();
+        interfaceModule_.resetAll();
+        paramsVersion_ = 0;
     }
 
-    bool isActive() const { return active_; }
-    bool isReleasing() const { return releasing_; }
-    int note() const { return midiNote_; }
-    uint64_t age() const { return ageCounter_; }
-    float level() const { return std::fabs(lastOutput_); }
+    void seed(uint32_t value) {
+        using flues::pm::Random;
+        source_.seed(Random::deriveSeed(value, 0));
+        delayLines_.seed(Random::deriveSeed(value, 1));
+        interfaceModule_.seed(Random::deriveSeed(value, 2));
+    }
 
-private:
     void syncParams(const FloozyParams& params) {
         if (paramsVersion_ == params.version) {
             return;
@@ -192,88 +133,123 @@ private:
         source_.setNoiseLevel(params.sourceNoise);
         source_.setDCLevel(params.sourceDC);
 
-        envelope_.setAttack(params.envelopeAttack);
-        envelope_.setRelease(params.envelopeRelease);
-
         interfaceModule_.setType(static_cast<int>(std::round(params.interfaceType)));
         interfaceModule_.setIntensity(params.interfaceIntensity);
 
-        delayLines_.setTuning(params.tuning);
-        delayLines_.setRatio(params.ratio);
-
-        feedback_.setDelay1Gain(params.delay1Feedback);
-        feedback_.setDelay2Gain(params.delay2Feedback);
-        feedback_.setFilterGain(params.filterFeedback);
+        delayLines_.setTuningAndRatio(params.tuning, params.ratio);
+    }
 
-        filter_.setFrequency(params.filterFrequency);
-        filter_.setQ(params.filterQ);
-        filter_.setShape(params.filterShape);
+    float renderSource(float modulatedFrequency) {
+        return source_.process(modulatedFrequency);
+    }
 
-        modulation_.setFrequency(params.lfoFrequency);
-        modulation_.setTypeLevel(params.modulationTypeLevel);
+    flues::pm::DelayLinesModule::DelayOutputs renderResonator(float interfaceInput) {
+        const float interfaceOutput = interfaceModule_.process(interfaceInput);
+        const float clampedDelayInput = std::clamp(interfaceOutput, -1.0f, 1.0f);
+        return delayLines_.process(clampedDelayInput, frequency_);
     }
 
+    bool isActive() const { return active_; }
+    bool isReleasing() const { return releasing_; }
+    int note() const { return midiNote_; }
+    uint64_t age() const { return ageCounter_; }
+    float frequency() const { return frequency_; }
+    std::size_t slot() const { return slot_; }
+
+private:
     void resetModules() {
         source_.reset();
-        envelope_.reset();
         interfaceModule_.reset();
         delayLines_.reset();
-        feedback_.reset();
-        filter_.reset();
-        modulation_.reset();
-        dcBlockerX1_ = 0.0f;
-        dcBlockerY1_ = 0.0f;
-        prevDelayOutputs_ = {0.0f, 0.0f};
-        prevFilterOutput_ = 0.0f;
-        postReleaseDamp_ = 1.0f;
-        lastOutput_ = 0.0f;
         paramsVersion_ = 0;
     }
 
-    float dcBlock(float sample) {
-        const float y = sample - dcBlockerX1_ + 0.995f * dcBlockerY1_;
-        dcBlockerX1_ = sample;
-        dcBlockerY1_ = y;
-        return y;
-    }
-
     FloozySourceModule source_;
-    flues::pm::EnvelopeModule envelope_;
     flues::pm::InterfaceModule interfaceModule_;
     flues::pm::DelayLinesModule delayLines_;
-    flues::pm::FeedbackModule feedback_;
-    flues::pm::FilterModule filter_;
-    flues::pm::ModulationModule modulation_;
 
     float frequency_;
     bool active_;
     bool releasing_;
     int midiNote_;
-    float dcBlockerX1_;
-    float dcBlockerY1_;
-    flues::pm::DelayLinesModule::DelayOutputs prevDelayOutputs_;
-    float prevFilterOutput_;
-    float postReleaseDamp_;
     uint64_t paramsVersion_;
     uint64_t ageCounter_;
-    float lastOutput_;
+    std::size_t slot_;
 };
 
+// Voice count of the bank; a multiple of VoiceLaneGroup::kLanes, at most 64.
+#ifndef FLOOZY_POLY_MAX_VOICES
+#define FLOOZY_POLY_MAX_VOICES 8
+#endif
+
 class FloozyPolyEngine {
 public:
-    static constexpr size_t kMaxVoices = 8;
+    static constexpr size_t kMaxVoices = FLOOZY_POLY_MAX_VOICES;
+    static constexpr size_t kLaneGroups = kMaxVoices / VoiceLaneGroup::kLanes;
+    static_assert(kMaxVoices % VoiceLaneGroup::kLanes == 0,
+                  "voice count must fill whole lane groups");
+    static_assert(kMaxVoices <= 64, "the voice allocator tracks at most 64 voices");
+
+    // Lane groups are only handed to the render threads when at least two
+    // are sounding and the block is long enough to amortise the handoff;
+    // longer blocks are rendered in kRenderChunk pieces.
+    static constexpr uint32_t kMinParallelFrames = 64;
+    static constexpr uint32_t kRenderChunk = 256;
+
+    // While the cutoff/Q glide runs, blocks are rendered in pieces of this
+    // many frames with the SVF coefficients stepped in between, so a long
+    // host block does not take the whole glide in one jump.
+    static constexpr uint32_t kFilterGlideChunk = 32;
 
     explicit FloozyPolyEngine(float sampleRate = 44100.0f)
         : sampleRate_(sampleRate),
+          voices_(makeVoices(sampleRate, std::make_index_sequence<kMaxVoices>{})),
           reverb_(sampleRate),
-          voiceAgeCounter_(0) {
-        for (auto& voice : voices_) {
-            voice = std::make_unique<FloozyVoice>(sampleRate_);
-        }
+          envelopeControl_(sampleRate),
+          filterControl_(sampleRate),
+          modulationControl_(sampleRate),
+          renderLaneGroup_(selectLaneGroupRenderer<FloozyVoice>()),
+          coefficientsVersion_(0),
+          voiceAgeCounter_(0),
+          noiseSeed_(flues::pm::Random::nextDefaultSeed()) {
+        seed(noiseSeed_);
         reverb_.setSize(params_.reverbSize);
         reverb_.setLevel(params_.reverbLevel);
     }
 
+    // Upper bound of the renderThreads port: one thread per lane group of
+    // the largest bank.
+    static constexpr uint32_t kMaxRenderThreads = 8;
+
+    // Starts the workers that setRenderThreads() can later put to use: up
+    // to `threads` threads, the caller included, never more than one per
+    // lane group and never more than RenderWorkerPool's process-wide budget
+    // allows, so with a single group no thread is started. Idle workers
+    // sleep. Not real-time safe: call from instantiate() or another
+    // non-audio thread.
+    void reserveRenderThreads(uint32_t threads) {
+        const uint32_t workers = std::clamp<uint32_t>(threads, 1, kLaneGroups) - 1;
+        renderWorkers_ = 0;
+        if (renderPool_ && renderPool_->workerCount() == workers) {
+            return;
+        }
+        renderPool_.reset();
+        if (workers > 0) {
+            renderPool_ = std::make_unique<RenderWorkerPool>(workers, &renderGroupJob, this);
+        }
+    }
+
+    // Renders lane groups on up to `value` threads, the caller included,
+    // out of those reserveRenderThreads() started; 1 renders everything on
+    // the caller's thread. Real-time safe.
+    void setRenderThreads(float value) {
+        const long threads = std::clamp(std::lround(value), 1L, static_cast<long>(kMaxRenderThreads));
+        const uint32_t available = renderPool_ ? renderPool_->workerCount() : 0;
+        renderWorkers_ = std::min(static_cast<uint32_t>(threads) - 1, available);
+    }
+
+    uint32_t renderThreads() const { return renderWorkers_ + 1; }
+
     void setAlgorithm(float value) { setAndBump(params_.sourceAlgorithm, std::clamp(value, 0.0f, 6.0f)); }
     void setParam1(float value) { setAndBump(params_.sourceParam1, std::clamp(value, 0.0f, 1.0f)); }
     void setParam2(float value) { setAndBump(params_.sourceParam2, std::clamp(value, 0.0f, 1.0f)); }
@@ -310,103 +286,301 @@ public:
             reverb_.setLevel(clamped);
         }
     }
+    void setReverbMode(float value) { reverb_.setMode(static_cast<int>(std::round(value))); }
     void setMasterGain(float value) { setAndBump(params_.masterGain, std::clamp(value, 0.0f, 1.0f)); }
 
+    // A repeated note retriggers its own voice; otherwise the lowest idle
+    // voice is used, or the earliest released one is stolen, or failing
+    // that the oldest held one (see flues::pm::VoiceAllocator).
     void noteOn(int midiNote, float frequency) {
-        if (auto* existing = findVoiceByNote(midiNote)) {
-            existing->noteOn(midiNote, frequency, params_, ++voiceAgeCounter_);
-            return;
-        }
-
-        if (auto* idle = findIdleVoice()) {
-            idle->noteOn(midiNote, frequency, params_, ++voiceAgeCounter_);
+        if (!VoiceAllocator::isValidNote(midiNote)) {
             return;
         }
-
-        auto* victim = selectVoiceToSteal();
-        if (victim) {
-            victim->noteOn(midiNote, frequency, params_, ++voiceAgeCounter_);
-        }
+        startVoice(voices_[allocator_.noteOn(midiNote)], midiNote, frequency);
     }
 
     void noteOff(int midiNote) {
-        if (auto* voice = findVoiceByNote(midiNote)) {
-            voice->noteOff();
+        const int slot = allocator_.noteOff(midiNote);
+        if (slot != VoiceAllocator::kNoVoice) {
+            FloozyVoice& voice = voices_[static_cast<size_t>(slot)];
+            voice.noteOff();
+            laneGroupFor(voice).releaseLane(laneFor(voice));
         }
     }
 
     void allNotesOff() {
         for (auto& voice : voices_) {
-            voice->forceStop();
+            voice.forceStop();
+            laneGroupFor(voice).clearLane(laneFor(voice));
         }
+        allocator_.reset(kMaxVoices);
+        groupLanes_.fill(0);
         reverb_.reset();
     }
 
-    float process() {
-        float accum = 0.0f;
+    // allNotesOff() plus the state it leaves behind: every voice's modules,
+    // the filter glide, voice ages and noise seeds return to their initial
+    // values. Parameters are kept and nothing is allocated, so activate()
+    // can call this instead of rebuilding the engine.
+    void resetAll() {
+        allNotesOff();
         for (auto& voice : voices_) {
-            accum += voice->process(params_);
+            voice.resetAll();
         }
-        return reverb_.process(accum);
+        filterControl_.reset();
+        updateFilterCoefficients();
+        voiceAgeCounter_ = 0;
+        seed(noiseSeed_);
     }
 
-private:
-    void setAndBump(float& target, float value) {
-        if (target == value) {
-            return;
+    // Reseeds every voice's noise sources so renders are reproducible.
+    void seed(uint32_t value) {
+        noiseSeed_ = value;
+        for (size_t i = 0; i < kMaxVoices; ++i) {
+            voices_[i].seed(flues::pm::Random::deriveSeed(value, static_cast<uint32_t>(i)));
         }
-        target = value;
-        params_.bump();
     }
 
-    FloozyVoice* findVoiceByNote(int midiNote) {
-        for (auto& voice : voices_) {
-            if (voice->isActive() && voice->note() == midiNote) {
-                return voice.get();
+    float process() {
+        float sample = 0.0f;
+        processBlock(&sample, 1);
+        return sample;
+    }
+
+    // Renders frames samples of the summed voices plus reverb. Voices are
+    // processed a lane group at a time with the kernel picked at
+    // construction (AVX, SSE or scalar), spread over the render threads
+    // when setRenderThreads() asks for them.
+    void processBlock(float* out, uint32_t frames) {
+        std::fill(out, out + frames, 0.0f);
+
+        if (coefficientsVersion_ != params_.version) {
+            updateCoefficients();
+        }
+        // Cutoff and Q changes glide in kFilterGlideChunk steps while
+        // anything sounds; with every voice idle they jump straight to the
+        // new values.
+        uint32_t done = 0;
+        while (done < frames) {
+            uint32_t n = frames - done;
+            if (!filterControl_.isSettled()) {
+                if (allocator_.anyActive()) {
+                    n = std::min(n, kFilterGlideChunk);
+                    filterControl_.advance(n);
+                } else {
+                    filterControl_.reset();
+                }
+                updateFilterCoefficients();
             }
+            renderVoices(out + done, n);
+            done += n;
         }
-        return nullptr;
+
+        reverb_.processBlock(out, frames);
     }
 
-    FloozyVoice* findIdleVoice() {
-        for (auto& voice : voices_) {
-            if (!voice->isActive()) {
-                return voice.get();
+private:
+    // Adds frames samples of every sounding voice to out.
+    void renderVoices(float* out, uint32_t frames) {
+        const uint32_t jobs = collectActiveGroups();
+        if (renderWorkers_ > 0 && jobs > 1 && frames >= kMinParallelFrames) {
+            renderGroupsParallel(out, frames, jobs);
+        } else {
+            for (uint32_t job = 0; job < jobs; ++job) {
+                const size_t group = activeGroups_[job];
+                const uint32_t remaining = renderLaneGroup_(
+                    laneGroups_[group], voices_.data() + group * VoiceLaneGroup::kLanes,
+                    coefficients_, out, frames, activeLanes_[job]);
+                retireLanes(group, activeLanes_[job] & ~remaining);
             }
         }
-        return nullptr;
     }
 
-    FloozyVoice* selectVoiceToSteal() {
-        FloozyVoice* candidate = nullptr;
-        uint64_t oldestAge = std::numeric_limits<uint64_t>::max();
+    // Per-job dry output for the parallel path, one cache-line-aligned row
+    // per lane group so the render threads never share a line.
+    struct alignas(64) GroupScratch {
+        std::array<float, kRenderChunk> samples{};
+    };
 
-        for (auto& voice : voices_) {
-            if (voice->isReleasing() && voice->age() < oldestAge) {
-                candidate = voice.get();
-                oldestAge = voice->age();
+    using VoiceAllocator = flues::pm::VoiceAllocator<kMaxVoices>;
+    using VoiceArray = std::array<FloozyVoice, kMaxVoices>;
+
+    // Voices are neither copyable nor movable (their interface pools point
+    // into themselves), so the array is built in place, each knowing its slot.
+    template <size_t... Slots>
+    static VoiceArray makeVoices(float sampleRate, std::index_sequence<Slots...>) {
+        return VoiceArray{{FloozyVoice(sampleRate, Slots)...}};
+    }
+
+    // Fills activeGroups_/activeLanes_ with the lane groups that have a
+    // sounding voice, syncing those voices' parameters on the way.
+    uint32_t collectActiveGroups() {
+        uint32_t jobs = 0;
+        for (size_t group = 0; group < kLaneGroups; ++group) {
+            const uint32_t activeLanes = groupLanes_[group];
+            if (activeLanes == 0) {
+                continue;
+            }
+            FloozyVoice* groupVoices = voices_.data() + group * VoiceLaneGroup::kLanes;
+            for (uint32_t lanes = activeLanes; lanes != 0; lanes &= lanes - 1) {
+                groupVoices[__builtin_ctz(lanes)].syncParams(params_);
             }
+            activeGroups_[jobs] = static_cast<uint32_t>(group);
+            activeLanes_[jobs] = activeLanes;
+            ++jobs;
         }
+        return jobs;
+    }
 
-        if (candidate) {
-            return candidate;
+    // Hands the voices the kernel stopped back to the allocator. Audio
+    // thread only: the render threads just report the lanes still sounding.
+    void retireLanes(size_t group, uint32_t stoppedLanes) {
+        groupLanes_[group] &= ~stoppedLanes;
+        for (; stoppedLanes != 0; stoppedLanes &= stoppedLanes - 1) {
+            allocator_.voiceStopped(group * VoiceLaneGroup::kLanes + __builtin_ctz(stoppedLanes));
         }
+    }
 
-        float lowestLevel = std::numeric_limits<float>::max();
-        for (auto& voice : voices_) {
-            if (voice->level() < lowestLevel) {
-                lowestLevel = voice->level();
-                candidate = voice.get();
+    // Each lane group renders into its own scratch row on whichever thread
+    // claims it; the rows are then summed in group order, which keeps the
+    // output bit-identical to the inline path.
+    void renderGroupsParallel(float* out, uint32_t frames, uint32_t jobs) {
+        uint32_t done = 0;
+        while (done < frames) {
+            const uint32_t n = std::min(frames - done, kRenderChunk);
+            if (done > 0) {
+                // Voices stop inside the kernel; drop them before the next piece.
+                jobs = collectActiveGroups();
             }
+            jobFrames_ = n;
+            renderPool_->run(jobs, renderWorkers_);
+            for (uint32_t job = 0; job < jobs; ++job) {
+                retireLanes(activeGroups_[job], activeLanes_[job] & ~remainingLanes_[job]);
+                const float* scratch = groupScratch_[job].samples.data();
+                for (uint32_t i = 0; i < n; ++i) {
+                    out[done + i] += scratch[i];
+                }
+            }
+            done += n;
+        }
+    }
+
+    static void renderGroupJob(void* context, uint32_t job) {
+        auto& self = *static_cast<FloozyPolyEngine*>(context);
+        const size_t group = self.activeGroups_[job];
+        float* scratch = self.groupScratch_[job].samples.data();
+        std::fill(scratch, scratch + self.jobFrames_, 0.0f);
+        self.remainingLanes_[job] = self.renderLaneGroup_(
+            self.laneGroups_[group], self.voices_.data() + group * VoiceLaneGroup::kLanes,
+            self.coefficients_, scratch, self.jobFrames_, self.activeLanes_[job]);
+    }
+
+    void setAndBump(float& target, float value) {
+        if (target == value) {
+            return;
+        }
+        target = value;
+        params_.bump();
+    }
+
+    void startVoice(FloozyVoice& voice, int midiNote, float frequency) {
+        voice.noteOn(midiNote, frequency, params_, ++voiceAgeCounter_);
+        laneGroupFor(voice).startLane(laneFor(voice), frequency);
+        groupLanes_[voice.slot() / VoiceLaneGroup::kLanes] |= 1u << laneFor(voice);
+    }
+
+    VoiceLaneGroup& laneGroupFor(const FloozyVoice& voice) {
+        return laneGroups_[voice.slot() / VoiceLaneGroup::kLanes];
+    }
+
+    static size_t laneFor(const FloozyVoice& voice) {
+        return voice.slot() % VoiceLaneGroup::kLanes;
+    }
+
+    void updateCoefficients() {
+        coefficientsVersion_ = params_.version;
+
+        envelopeControl_.setAttack(params_.envelopeAttack);
+        envelopeControl_.setRelease(params_.envelopeRelease);
+        feedbackControl_.setDelay1Gain(params_.delay1Feedback);
+        feedbackControl_.setDelay2Gain(params_.delay2Feedback);
+        feedbackControl_.setFilterGain(params_.filterFeedback);
+        filterControl_.setFrequency(params_.filterFrequency);
+        filterControl_.setQ(params_.filterQ);
+        filterControl_.setShape(params_.filterShape);
+        modulationControl_.setFrequency(params_.lfoFrequency);
+        modulationControl_.setTypeLevel(params_.modulationTypeLevel);
+
+        coefficients_.attackIncrement = envelopeControl_.getAttackIncrement();
+        coefficients_.releaseIncrement = envelopeControl_.getReleaseIncrement();
+
+        const float amDepth = modulationControl_.getAmDepth();
+        coefficients_.lfoIncrement = modulationControl_.getPhaseIncrement();
+        coefficients_.amOffset = 1.0f - amDepth * 0.5f;
+        coefficients_.amScale = amDepth * 0.5f;
+        coefficients_.fmScale = modulationControl_.getFmDepth() * 0.1f;
+
+        coefficients_.delay1Gain = feedbackControl_.getDelay1Gain();
+        coefficients_.delay2Gain = feedbackControl_.getDelay2Gain();
+        coefficients_.filterGain = feedbackControl_.getFilterGain();
+
+        updateFilterCoefficients();
+        const float shape = filterControl_.getShape();
+        if (shape < 0.5f) {
+            const float mix = shape * 2.0f;
+            coefficients_.lowWeight = 1.0f - mix;
+            coefficients_.bandWeight = mix;
+            coefficients_.highWeight = 0.0f;
+        } else {
+            const float mix = (shape - 0.5f) * 2.0f;
+            coefficients_.lowWeight = 0.0f;
+            coefficients_.bandWeight = 1.0f - mix;
+            coefficients_.highWeight = mix;
         }
-        return candidate;
+
+        coefficients_.masterGain = params_.masterGain;
+    }
+
+    void updateFilterCoefficients() {
+        const flues::pm::SvfCoefficients& svf = filterControl_.getCoefficients();
+        coefficients_.svfK = svf.k;
+        coefficients_.svfA1 = svf.a1;
+        coefficients_.svfA2 = svf.a2;
+        coefficients_.svfA3 = svf.a3;
     }
 
     float sampleRate_;
     FloozyParams params_;
-    std::array<std::unique_ptr<FloozyVoice>, kMaxVoices> voices_;
+    // In slot order, so a lane group's voices are adjacent.
+    VoiceArray voices_;
+    std::array<VoiceLaneGroup, kLaneGroups> laneGroups_;
+    VoiceAllocator allocator_;
+    // Sounding lanes per group, kept in step with the allocator.
+    std::array<uint32_t, kLaneGroups> groupLanes_{};
     flues::pm::ReverbModule reverb_;
+
+    // Control-only module instances: they hold no audio state and exist to
+    // turn normalised parameters into the shared per-block coefficients.
+    flues::pm::EnvelopeModule envelopeControl_;
+    flues::pm::FeedbackModule feedbackControl_;
+    flues::pm::FilterModule filterControl_;
+    flues::pm::ModulationModule modulationControl_;
+
+    VoiceBankCoefficients coefficients_;
+    LaneGroupRenderer<FloozyVoice> renderLaneGroup_;
+    uint64_t coefficientsVersion_;
     uint64_t voiceAgeCounter_;
+    uint32_t noiseSeed_;
+
+    std::array<uint32_t, kLaneGroups> activeGroups_{};
+    std::array<uint32_t, kLaneGroups> activeLanes_{};
+    std::array<uint32_t, kLaneGroups> remainingLanes_{};
+    std::array<GroupScratch, kLaneGroups> groupScratch_{};
+    uint32_t jobFrames_ = 0;
+    uint32_t renderWorkers_ = 0;
+    // Last, so the render threads are joined before anything they touch
+    // is destroyed.
+    std::unique_ptr<RenderWorkerPool> renderPool_;
 };
 
 } // namespace flues::floozy_poly
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "SimdLanes.hpp"
+
+namespace flues::floozy_poly {
+
+// Per-block constants shared by every voice. These are the values the pm
+// modules would otherwise recompute per voice and per sample.
+struct VoiceBankCoefficients {
+    float attackIncrement = 0.0f;
+    float releaseIncrement = 0.0f;
+
+    float lfoIncrement = 0.0f;
+    float amOffset = 1.0f;
+    float amScale = 0.0f;
+    float fmScale = 0.0f;
+
+    float delay1Gain = 0.0f;
+    float delay2Gain = 0.0f;
+    float filterGain = 0.0f;
+
+    // TPT state-variable filter (see flues::pm::SvfCoefficients).
+    float svfK = 1.0f;
+    float svfA1 = 1.0f;
+    float svfA2 = 0.0f;
+    float svfA3 = 0.0f;
+    float lowWeight = 1.0f;
+    float bandWeight = 0.0f;
+    float highWeight = 0.0f;
+
+    float masterGain = 0.0f;
+};
+
+// Structure-of-arrays state for eight voices: envelope, LFO, DC blocker,
+// feedback taps, SVF and post-release damping. One group fills an AVX
+// register (or two SSE registers) per field. Source, interface and delay
+// lines stay per voice because they branch on algorithm/type.
+struct alignas(32) VoiceLaneGroup {
+    static constexpr std::size_t kLanes = 8;
+    using Lanes = std::array<float, kLanes>;
+
+    alignas(32) Lanes frequency{};
+    alignas(32) Lanes gate{};
+    alignas(32) Lanes envelope{};
+    alignas(32) Lanes envelopeActive{};
+    alignas(32) Lanes lfoPhase{};
+    alignas(32) Lanes dcX1{};
+    alignas(32) Lanes dcY1{};
+    alignas(32) Lanes postReleaseDamp{};
+    alignas(32) Lanes prevDelay1{};
+    alignas(32) Lanes prevDelay2{};
+    alignas(32) Lanes prevFilter{};
+    alignas(32) Lanes svfIc1{};
+    alignas(32) Lanes svfIc2{};
+    alignas(32) Lanes lastOutput{};
+
+    void startLane(std::size_t lane, float laneFrequency) {
+        clearLane(lane);
+        frequency[lane] = laneFrequency;
+        gate[lane] = 1.0f;
+        envelopeActive[lane] = 1.0f;
+        postReleaseDamp[lane] = 1.0f;
+    }
+
+    void releaseLane(std::size_t lane) {
+        gate[lane] = 0.0f;
+    }
+
+    void clearLane(std::size_t lane) {
+        gate[lane] = 0.0f;
+        envelope[lane] = 0.0f;
+        envelopeActive[lane] = 0.0f;
+        lfoPhase[lane] = 0.0f;
+        dcX1[lane] = 0.0f;
+        dcY1[lane] = 0.0f;
+        postReleaseDamp[lane] = 0.0f;
+        prevDelay1[lane] = 0.0f;
+        prevDelay2[lane] = 0.0f;
+        prevFilter[lane] = 0.0f;
+        svfIc1[lane] = 0.0f;
+        svfIc2[lane] = 0.0f;
+        lastOutput[lane] = 0.0f;
+    }
+};
+
+// Renders one lane group and accumulates the dry voice sum into out.
+// activeLanes is a bitmask of lanes holding a sounding voice; the vector
+// stages run across the whole group, while the per-voice stages and the
+// scalar fallback only touch active lanes. Voices that fall silent are
+// stopped in place, exactly as FloozyVoice::process() used to do, and the
+// lanes still sounding at the end are returned.
+template <class V, class Voice>
+inline uint32_t renderLaneGroup(VoiceLaneGroup& group,
+                                Voice* voices,
+                                const VoiceBankCoefficients& c,
+                                float* out,
+                                uint32_t frames,
+                                uint32_t activeLanes) {
+    constexpr std::size_t kLanes = VoiceLaneGroup::kLanes;
+    constexpr int kStep = V::kWidth;
+    static_assert(kLanes % kStep == 0, "lane width must divide the group");
+
+    const float twoPi = 2.0f * static_cast<float>(M_PI);
+
+    alignas(32) float modulatedFrequency[kLanes] = {};
+    alignas(32) float amplitude[kLanes] = {};
+    alignas(32) float source[kLanes] = {};
+    alignas(32) float interfaceInput[kLanes] = {};
+    alignas(32) float delay1[kLanes] = {};
+    alignas(32) float delay2[kLanes] = {};
+    alignas(32) float output[kLanes] = {};
+    alignas(32) float lfo[kLanes] = {};
+
+    const auto chunkActive = [&](std::size_t first) {
+        return ((activeLanes >> first) & ((1u << kStep) - 1u)) != 0u;
+    };
+
+    for (uint32_t i = 0; i < frames && activeLanes != 0u; ++i) {
+        // Modulation: LFO phase, AM gain and FM-scaled frequency.
+        for (std::size_t l = 0; l < kLanes; l += kStep) {
+            if (!chunkActive(l)) {
+                continue;
+            }
+            V phase = V::load(&group.lfoPhase[l]) + V::broadcast(c.lfoIncrement);
+            phase = V::select(V::greater(phase, V::broadcast(twoPi)),
+                              phase - V::broadcast(twoPi),
+                              phase);
+            V::store(&group.lfoPhase[l], phase);
+
+            lanesSin<V>(&group.lfoPhase[l], &lfo[l]);
+            const V sine = V::load(&lfo[l]);
+            V::store(&amplitude[l], V::broadcast(c.amOffset) + sine * V::broadcast(c.amScale));
+            V::store(&modulatedFrequency[l],
+                     V::load(&group.frequency[l]) * (V::broadcast(1.0f) + sine * V::broadcast(c.fmScale)));
+        }
+
+        for (std::size_t l = 0; l < kLanes; ++l) {
+            source[l] = (activeLanes & (1u << l))
+                ? voices[l].renderSource(modulatedFrequency[l])
+                : 0.0f;
+        }
+
+        // Envelope, feedback mix, DC blocker and post-release damping.
+        for (std::size_t l = 0; l < kLanes; l += kStep) {
+            if (!chunkActive(l)) {
+                continue;
+            }
+            const V one = V::broadcast(1.0f);
+            const V zero = V::broadcast(0.0f);
+            const V half = V::broadcast(0.5f);
+
+            const V env = V::load(&group.envelope[l]);
+            const auto gateOn = V::greater(V::load(&group.gate[l]), half);
+            const V attack = V::min(env + V::broadcast(c.attackIncrement), one);
+            const V release = env - V::broadcast(c.releaseIncrement);
+            const V nextEnv = V::select(gateOn, attack, V::max(release, zero));
+            const V envActive = V::select(gateOn,
+                                          V::load(&group.envelopeActive[l]),
+                                          V::select(V::less(release, zero), zero,
+                                                    V::load(&group.envelopeActive[l])));
+            V::store(&group.envelope[l], nextEnv);
+            V::store(&group.envelopeActive[l], envActive);
+
+            const V damp = V::select(V::greater(envActive, half),
+                                     one,
+                                     V::load(&group.postReleaseDamp[l]) * V::broadcast(0.995f));
+            V::store(&group.postReleaseDamp[l], V::flush(damp));
+
+            const V feedback = V::load(&group.prevDelay1[l]) * V::broadcast(c.delay1Gain) +
+                               V::load(&group.prevDelay2[l]) * V::broadcast(c.delay2Gain) +
+                               V::load(&group.prevFilter[l]) * V::broadcast(c.filterGain);
+            const V dc = feedback - V::load(&group.dcX1[l]) +
+                         V::broadcast(0.995f) * V::load(&group.dcY1[l]);
+            V::store(&group.dcX1[l], feedback);
+            V::store(&group.dcY1[l], V::flush(dc));
+
+            V::store(&interfaceInput[l], V::load(&source[l]) * nextEnv + dc * damp);
+        }
+
+        for (std::size_t l = 0; l < kLanes; ++l) {
+            if (activeLanes & (1u << l)) {
+                const auto delays = voices[l].renderResonator(interfaceInput[l]);
+                delay1[l] = delays.delay1;
+                delay2[l] = delays.delay2;
+            } else {
+                delay1[l] = 0.0f;
+                delay2[l] = 0.0f;
+            }
+        }
+
+        // TPT (trapezoidal) SVF with a fixed shape blend, then AM and master gain.
+        for (std::size_t l = 0; l < kLanes; l += kStep) {
+            if (!chunkActive(l)) {
+                V::store(&output[l], V::broadcast(0.0f));
+                continue;
+            }
+            const V zero = V::broadcast(0.0f);
+            const V two = V::broadcast(2.0f);
+            const V a2 = V::broadcast(c.svfA2);
+            const V d1 = V::load(&delay1[l]);
+            const V d2 = V::load(&delay2[l]);
+            const V mix = (d1 + d2) * V::broadcast(0.5f);
+
+            V ic1 = V::load(&group.svfIc1[l]);
+            V ic2 = V::load(&group.svfIc2[l]);
+            const V v3 = mix - ic2;
+            const V band = V::broadcast(c.svfA1) * ic1 + a2 * v3;
+            const V low = ic2 + a2 * ic1 + V::broadcast(c.svfA3) * v3;
+            const V high = mix - V::broadcast(c.svfK) * band - low;
+            ic1 = two * band - ic1;
+            ic2 = two * low - ic2;
+
+            V::store(&group.svfIc1[l], V::flush(V::select(V::finite(ic1), ic1, zero)));
+            V::store(&group.svfIc2[l], V::flush(V::select(V::finite(ic2), ic2, zero)));
+
+            const V filtered = low * V::broadcast(c.lowWeight) +
+                               band * V::broadcast(c.bandWeight) +
+                               high * V::broadcast(c.highWeight);
+            const V voiceOut = filtered * V::load(&amplitude[l]) * V::broadcast(c.masterGain);
+
+            V::store(&group.prevDelay1[l], d1);
+            V::store(&group.prevDelay2[l], d2);
+            V::store(&group.prevFilter[l], filtered);
+            V::store(&group.lastOutput[l], voiceOut);
+            V::store(&output[l], voiceOut);
+        }
+
+        float sum = 0.0f;
+        for (std::size_t l = 0; l < kLanes; ++l) {
+            if (!(activeLanes & (1u << l))) {
+                continue;
+            }
+            sum += output[l];
+
+            if (group.envelopeActive[l] == 0.0f &&
+                group.postReleaseDamp[l] < 1e-4f &&
+                std::fabs(output[l]) < 1e-5f &&
+                std::fabs(delay1[l]) < 1e-5f &&
+                std::fabs(delay2[l]) < 1e-5f) {
+                voices[l].forceStop();
+                group.clearLane(l);
+                activeLanes &= ~(1u << l);
+            }
+        }
+        out[i] += sum;
+    }
+    return activeLanes;
+}
+
+template <class Voice>
+using LaneGroupRenderer = uint32_t (*)(VoiceLaneGroup&,
+                                       Voice*,
+                                       const VoiceBankCoefficients&,
+                                       float*,
+                                       uint32_t,
+                                       uint32_t);
+
+#if defined(FLOOZY_POLY_HAS_AVX_LANES)
+// flatten pulls the whole kernel, including the per-voice module calls, into
+// this AVX-targeted body so no baseline-ISA caller ever sees AVX code.
+template <class Voice>
+__attribute__((target("avx"), flatten))
+uint32_t renderLaneGroupAvx(VoiceLaneGroup& group,
+                            Voice* voices,
+                            const VoiceBankCoefficients& c,
+                            float* out,
+                            uint32_t frames,
+                            uint32_t activeLanes) {
+    return renderLaneGroup<AvxLanes, Voice>(group, voices, c, out, frames, activeLanes);
+}
+#endif
+
+// Picks the widest kernel the running CPU supports. Building with
+// FLOOZY_POLY_SCALAR_LANES forces the portable scalar path.
+template <class Voice>
+LaneGroupRenderer<Voice> selectLaneGroupRenderer() {
+#if defined(FLOOZY_POLY_HAS_AVX_LANES)
+    if (__builtin_cpu_supports("avx")) {
+        return &renderLaneGroupAvx<Voice>;
+    }
+#endif
+#if defined(FLOOZY_POLY_HAS_SSE_LANES)
+    return &renderLaneGroup<SseLanes, Voice>;
+#else
+    return &renderLaneGroup<ScalarLanes, Voice>;
+#endif
+}
+
+} // namespace flues::floozy_poly
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../../pm-synth/src/DenormalGuard.hpp"
+
+#if defined(__linux__)
+#include <climits>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace flues::floozy_poly {
+
+/**
+ * Fixed set of render threads that run a batch of independent jobs per
+ * audio block together with the calling (audio) thread.
+ *
+ * run() publishes the batch in one atomic word - generation, job count and
+ * next unclaimed index - and every participant, the caller included,
+ * claims jobs from it with compare-and-swap until none are left. Nothing
+ * takes a lock or allocates. Idle workers spin briefly and then sleep on a
+ * futex, so a block only pays for a wake-up syscall when a worker actually
+ * went to sleep; the caller spin-waits for the last job to finish.
+ *
+ * Threads are created and joined only in the constructor and destructor,
+ * never on the audio thread. All pools in the process share one budget of
+ * workers, one fewer than the CPU count, so several plugin instances
+ * cannot oversubscribe the machine with real-time threads; a pool gets
+ * fewer workers than it asked for once the budget is spent.
+ */
+class RenderWorkerPool {
+public:
+    using Job = void (*)(void* context, uint32_t index);
+
+    RenderWorkerPool(uint32_t workerCount, Job job, void* context)
+        : job_(job), context_(context) {
+        workerCount = reserveWorkers(workerCount);
+        threads_.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i) {
+            threads_.emplace_back([this, i] { workerLoop(i); });
+            promoteToRealtime(threads_.back());
+        }
+    }
+
+    ~RenderWorkerPool() {
+        stop_.store(true, std::memory_order_relaxed);
+        signal_.fetch_add(1, std::memory_order_seq_cst);
+        wakeAll();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+        liveWorkers_.fetch_sub(workerCount(), std::memory_order_relaxed);
+    }
+
+    RenderWorkerPool(const RenderWorkerPool&) = delete;
+    RenderWorkerPool& operator=(const RenderWorkerPool&) = delete;
+
+    uint32_t workerCount() const { return static_cast<uint32_t>(threads_.size()); }
+
+    // Runs job(context, 0..count-1) across the first `workers` workers and
+    // the caller and returns once every job has finished. The other workers
+    // go back to sleep. Audio thread only.
+    void run(uint32_t count, uint32_t workers) {
+        if (count == 0) {
+            return;
+        }
+        generation_ = (generation_ + 1) & kGenerationMask;
+        remaining_.store(count, std::memory_order_relaxed);
+        participants_.store(workers, std::memory_order_relaxed);
+        claim_.store(pack(generation_, count, 0), std::memory_order_release);
+
+        signal_.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_seq_cst) != 0) {
+            wakeAll();
+        }
+
+        drainJobs();
+        while (remaining_.load(std::memory_order_acquire) != 0) {
+            cpuRelax();
+        }
+    }
+
+private:
+    static constexpr uint64_t kGenerationMask = 0xffffffffULL;
+    static constexpr int kSpinsBeforeSleep = 4096;
+
+    static uint32_t workerBudget() {
+        const uint32_t cpus = std::thread::hardware_concurrency();
+        return cpus > 1 ? cpus - 1 : 0;
+    }
+
+    // Takes up to `requested` workers from the process-wide budget.
+    static uint32_t reserveWorkers(uint32_t requested) {
+        const uint32_t budget = workerBudget();
+        uint32_t live = liveWorkers_.load(std::memory_order_relaxed);
+        for (;;) {
+            const uint32_t granted = std::min(requested, live < budget ? budget - live : 0);
+            if (liveWorkers_.compare_exchange_weak(live, live + granted,
+                                                   std::memory_order_relaxed)) {
+                return granted;
+            }
+        }
+    }
+
+    static uint64_t pack(uint64_t generation, uint64_t count, uint64_t index) {
+        return (generation << 32) | (count << 16) | index;
+    }
+
+    // The generation in the claim word keeps a participant that is late
+    // for one batch from claiming an index of the next.
+    bool claimJob(uint32_t& index) {
+        uint64_t current = claim_.load(std::memory_order_acquire);
+        for (;;) {
+            const uint32_t next = static_cast<uint32_t>(current & 0xffffu);
+            const uint32_t count = static_cast<uint32_t>((current >> 16) & 0xffffu);
+            if (next >= count) {
+                return false;
+            }
+            if (claim_.compare_exchange_weak(current, current + 1,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+                index = next;
+                return true;
+            }
+        }
+    }
+
+    void drainJobs() {
+        uint32_t index = 0;
+        while (claimJob(index)) {
+            job_(context_, index);
+            remaining_.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void workerLoop(uint32_t index) {
+        // The FP mode is per thread; match what run() sets on the audio thread.
+        const flues::pm::DenormalGuard denormalGuard;
+        uint32_t seen = signal_.load(std::memory_order_acquire);
+        bool participating = true;
+        for (;;) {
+            // A worker left out of the last batch sleeps straight away.
+            int spins = participating ? 0 : kSpinsBeforeSleep;
+            uint32_t current = signal_.load(std::memory_order_acquire);
+            while (current == seen) {
+                if (++spins < kSpinsBeforeSleep) {
+                    cpuRelax();
+                } else {
+                    sleepers_.fetch_add(1, std::memory_order_seq_cst);
+                    waitWhileEqual(seen);
+                    sleepers_.fetch_sub(1, std::memory_order_seq_cst);
+                    spins = 0;
+                }
+                current = signal_.load(std::memory_order_acquire);
+            }
+            seen = current;
+
+            if (stop_.load(std::memory_order_relaxed)) {
+                return;
+            }
+            participating = index < participants_.load(std::memory_order_relaxed);
+            if (participating) {
+                drainJobs();
+            }
+        }
+    }
+
+    void waitWhileEqual(uint32_t expected) {
+#if defined(__linux__)
+        // Returns at once if signal_ has already moved on, so a run() that
+        // lands between the check above and this call is not missed.
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&signal_), FUTEX_WAIT_PRIVATE,
+                expected, nullptr, nullptr, 0);
+#else
+        if (signal_.load(std::memory_order_seq_cst) == expected) {
+            std::this_thread::yield();
+        }
+#endif
+    }
+
+    void wakeAll() {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&signal_), FUTEX_WAKE_PRIVATE,
+                INT_MAX, nullptr, nullptr, 0);
+#endif
+    }
+
+    static void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    // Render threads should not be preempted by ordinary threads while the
+    // audio thread waits on them. Without the rights for SCHED_FIFO they
+    // simply keep the default policy.
+    static void promoteToRealtime(std::thread& thread) {
+#if defined(__linux__)
+        sched_param param{};
+        param.sched_priority = std::max(sched_get_priority_min(SCHED_FIFO), 1);
+        pthread_setschedparam(thread.native_handle(), SCHED_FIFO, &param);
+#else
+        (void)thread;
+#endif
+    }
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+                  "futex word must be a plain 32-bit integer");
+
+    Job job_;
+    void* context_;
+    std::vector<std::thread> threads_;
+    uint64_t generation_ = 0;
+
+    alignas(64) std::atomic<uint64_t> claim_{0};
+    alignas(64) std::atomic<uint32_t> remaining_{0};
+    alignas(64) std::atomic<uint32_t> signal_{0};
+    std::atomic<uint32_t> sleepers_{0};
+    std::atomic<uint32_t> participants_{0};
+    std::atomic<bool> stop_{false};
+
+    // Workers held by all pools in the process.
+    inline static std::atomic<uint32_t> liveWorkers_{0};
+};
+
+} // namespace flues::floozy_poly
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "../../pm-synth/src/DenormalGuard.hpp"
+
+// Minimal lane-vector types used by the voice bank. Each type exposes the
+// same static interface so the bank kernel can be written once and
+// instantiated per instruction set:
+//   ScalarLanes - one float per step, portable fallback
+//   SseLanes    - 4 floats (SSE2, baseline on x86-64)
+//   AvxLanes    - 8 floats; every function carries target("avx") so the
+//                 plugin TU itself can stay at the baseline ISA and pick
+//                 the AVX kernel at runtime.
+
+#if !defined(FLOOZY_POLY_SCALAR_LANES) && (defined(__SSE2__) || defined(_M_X64))
+#include <immintrin.h>
+#define FLOOZY_POLY_HAS_SSE_LANES 1
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FLOOZY_POLY_HAS_AVX_LANES 1
+#define FLOOZY_POLY_AVX_TARGET __attribute__((target("avx")))
+#endif
+#endif
+
+namespace flues::floozy_poly {
+
+struct ScalarLanes {
+    static constexpr int kWidth = 1;
+    using Mask = bool;
+
+    float v;
+
+    static ScalarLanes load(const float* p) { return {*p}; }
+    static void store(float* p, ScalarLanes a) { *p = a.v; }
+    static ScalarLanes broadcast(float x) { return {x}; }
+
+    friend ScalarLanes operator+(ScalarLanes a, ScalarLanes b) { return {a.v + b.v}; }
+    friend ScalarLanes operator-(ScalarLanes a, ScalarLanes b) { return {a.v - b.v}; }
+    friend ScalarLanes operator*(ScalarLanes a, ScalarLanes b) { return {a.v * b.v}; }
+
+    static ScalarLanes min(ScalarLanes a, ScalarLanes b) { return {std::min(a.v, b.v)}; }
+    static ScalarLanes max(ScalarLanes a, ScalarLanes b) { return {std::max(a.v, b.v)}; }
+    static ScalarLanes abs(ScalarLanes a) { return {std::fabs(a.v)}; }
+
+    static Mask less(ScalarLanes a, ScalarLanes b) { return a.v < b.v; }
+    static Mask greater(ScalarLanes a, ScalarLanes b) { return a.v > b.v; }
+    static Mask finite(ScalarLanes a) { return std::isfinite(a.v); }
+    static ScalarLanes select(Mask m, ScalarLanes a, ScalarLanes b) { return m ? a : b; }
+    // Zeroes subnormals where no DenormalGuard does (see flushDenormal()).
+    static ScalarLanes flush(ScalarLanes a) { return {flues::pm::flushDenormal(a.v)}; }
+};
+
+#if defined(FLOOZY_POLY_HAS_SSE_LANES)
+
+struct SseLanes {
+    static constexpr int kWidth = 4;
+    struct Mask {
+        __m128 m;
+    };
+
+    __m128 v;
+
+    static SseLanes load(const float* p) { return {_mm_load_ps(p)}; }
+    static void store(float* p, SseLanes a) { _mm_store_ps(p, a.v); }
+    static SseLanes broadcast(float x) { return {_mm_set1_ps(x)}; }
+
+    friend SseLanes operator+(SseLanes a, SseLanes b) { return {_mm_add_ps(a.v, b.v)}; }
+    friend SseLanes operator-(SseLanes a, SseLanes b) { return {_mm_sub_ps(a.v, b.v)}; }
+    friend SseLanes operator*(SseLanes a, SseLanes b) { return {_mm_mul_ps(a.v, b.v)}; }
+
+    static SseLanes min(SseLanes a, SseLanes b) { return {_mm_min_ps(a.v, b.v)}; }
+    static SseLanes max(SseLanes a, SseLanes b) { return {_mm_max_ps(a.v, b.v)}; }
+    static SseLanes abs(SseLanes a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+
+    static Mask less(SseLanes a, SseLanes b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+    static Mask greater(SseLanes a, SseLanes b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+    // x - x is 0 for finite x and NaN for +-inf/NaN; the ordered compare rejects NaN.
+    static Mask finite(SseLanes a) { return {_mm_cmpeq_ps(_mm_sub_ps(a.v, a.v), _mm_setzero_ps())}; }
+    static SseLanes select(Mask m, SseLanes a, SseLanes b) {
+        return {_mm_or_ps(_mm_and_ps(m.m, a.v), _mm_andnot_ps(m.m, b.v))};
+    }
+    static SseLanes flush(SseLanes a) {
+        if constexpr (flues::pm::DenormalGuard::isSupported()) {
+            return a;
+        } else {
+            return {_mm_and_ps(a.v, _mm_cmpge_ps(abs(a).v, _mm_set1_ps(1e-30f)))};
+        }
+    }
+};
+
+#endif
+
+#if defined(FLOOZY_POLY_HAS_AVX_LANES)
+
+struct AvxLanes {
+    static constexpr int kWidth = 8;
+    struct Mask {
+        __m256 m;
+    };
+
+    __m256 v;
+
+    FLOOZY_POLY_AVX_TARGET static AvxLanes load(const float* p) { return {_mm256_load_ps(p)}; }
+    FLOOZY_POLY_AVX_TARGET static void store(float* p, AvxLanes a) { _mm256_store_ps(p, a.v); }
+    FLOOZY_POLY_AVX_TARGET static AvxLanes broadcast(float x) { return {_mm256_set1_ps(x)}; }
+
+    FLOOZY_POLY_AVX_TARGET friend AvxLanes operator+(AvxLanes a, AvxLanes b) { return {_mm256_add_ps(a.v, b.v)}; }
+    FLOOZY_POLY_AVX_TARGET friend AvxLanes operator-(AvxLanes a, AvxLanes b) { return {_mm256_sub_ps(a.v, b.v)}; }
+    FLOOZY_POLY_AVX_TARGET friend AvxLanes operator*(AvxLanes a, AvxLanes b) { return {_mm256_mul_ps(a.v, b.v)}; }
+
+    FLOOZY_POLY_AVX_TARGET static AvxLanes min(AvxLanes a, AvxLanes b) { return {_mm256_min_ps(a.v, b.v)}; }
+    FLOOZY_POLY_AVX_TARGET static AvxLanes max(AvxLanes a, AvxLanes b) { return {_mm256_max_ps(a.v, b.v)}; }
+    FLOOZY_POLY_AVX_TARGET static AvxLanes abs(AvxLanes a) {
+        return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)};
+    }
+
+    FLOOZY_POLY_AVX_TARGET static Mask less(AvxLanes a, AvxLanes b) {
+        return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)};
+    }
+    FLOOZY_POLY_AVX_TARGET static Mask greater(AvxLanes a, AvxLanes b) {
+        return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)};
+    }
+    FLOOZY_POLY_AVX_TARGET static Mask finite(AvxLanes a) {
+        return {_mm256_cmp_ps(_mm256_sub_ps(a.v, a.v), _mm256_setzero_ps(), _CMP_EQ_OQ)};
+    }
+    FLOOZY_POLY_AVX_TARGET static AvxLanes select(Mask m, AvxLanes a, AvxLanes b) {
+        return {_mm256_blendv_ps(b.v, a.v, m.m)};
+    }
+    FLOOZY_POLY_AVX_TARGET static AvxLanes flush(AvxLanes a) {
+        if constexpr (flues::pm::DenormalGuard::isSupported()) {
+            return a;
+        } else {
+            return {_mm256_and_ps(a.v, _mm256_cmp_ps(abs(a).v, _mm256_set1_ps(1e-30f), _CMP_GE_OQ))};
+        }
+    }
+};
+
+#endif
+
+// sin(phase) for phase in [0, 2*pi], written against the lane interface so
+// all eight LFOs advance together. The argument is folded onto
+// [-pi/2, pi/2] and evaluated with an odd Taylor polynomial up to x^11,
+// which keeps the error below 1e-7 - well under what an LFO can resolve.
+// Takes pointers rather than V so no vector type crosses a function
+// boundary outside the AVX-targeted kernel.
+template <class V>
+inline void lanesSin(const float* phase, float* out) {
+    const float pi = static_cast<float>(M_PI);
+    const V x = V::load(phase) - V::broadcast(pi);
+    const V ax = V::abs(x);
+    const V f = V::min(ax, V::broadcast(pi) - ax);
+    const V f2 = f * f;
+
+    V poly = V::broadcast(-1.0f / 39916800.0f) * f2 + V::broadcast(1.0f / 362880.0f);
+    poly = poly * f2 - V::broadcast(1.0f / 5040.0f);
+    poly = poly * f2 + V::broadcast(1.0f / 120.0f);
+    poly = poly * f2 - V::broadcast(1.0f / 6.0f);
+    poly = poly * f2 + V::broadcast(1.0f);
+    const V s = poly * f;
+
+    // sin(phase) = -sin(x); the folded magnitude carries the sign of -x.
+    V::store(out, V::select(V::less(x, V::broadcast(0.0f)), s, V::broadcast(0.0f) - s));
+}
+
+} // namespace flues::floozy_poly
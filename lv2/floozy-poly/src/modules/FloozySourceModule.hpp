@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 
 #include "../../../pm-synth/src/Random.hpp"
 #include "../../../disyn/src/modules/OscillatorModule.hpp"
@@ -21,9 +22,14 @@ public:
           dcLevel(0.5f) {}
 
     void reset() {
+        oscillator.setParameters(algorithm, param1, param2);
         oscillator.reset();
     }
 
+    void seed(uint32_t value) {
+        rng.seed(value);
+    }
+
     void setAlgorithm(float value) {
         int index = static_cast<int>(std::round(std::clamp(value, 0.0f, 6.0f)));
         algorithm = static_cast<flues::disyn::AlgorithmType>(index);
@@ -1,11 +1,15 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <memory>
 
 #include "modules/FloozySourceModule.hpp"
 
+#include "../../pm-synth/src/DenormalGuard.hpp"
+#include "../../pm-synth/src/Profiler.hpp"
 #include "../../pm-synth/src/modules/EnvelopeModule.hpp"
 #include "../../pm-synth/src/modules/InterfaceModule.hpp"
 #include "../../pm-synth/src/modules/DelayLinesModule.hpp"
@@ -18,6 +22,9 @@ namespace flues::floozy {
 
 class FloozyEngine {
 public:
+    // Largest sub-block rendered in one pass; longer host buffers are split.
+    static constexpr uint32_t kMaxBlockSize = 64;
+
     explicit FloozyEngine(float sampleRate = 44100.0f)
         : sampleRate(sampleRate),
           source(sampleRate),
@@ -34,7 +41,10 @@ public:
           dcBlockerX1(0.0f),
           dcBlockerY1(0.0f),
           prevDelayOutputs{0.0f, 0.0f},
-          prevFilterOutput(0.0f) {}
+          prevFilterOutput(0.0f),
+          noiseSeed(flues::pm::Random::nextDefaultSeed()) {
+        seed(noiseSeed);
+    }
 
     void noteOn(float freq) {
         frequency = freq;
@@ -48,7 +58,6 @@ public:
         feedback.reset();
         filter.reset();
         modulation.reset();
-        reverb.reset();
         dcBlockerX1 = 0.0f;
         dcBlockerY1 = 0.0f;
         prevDelayOutputs = {0.0f, 0.0f};
@@ -62,9 +71,44 @@ public:
         interfaceModule.setGate(false);
     }
 
+    // Reseeds every noise source so renders are reproducible.
+    void seed(uint32_t value) {
+        using flues::pm::Random;
+        noiseSeed = value;
+        source.seed(Random::deriveSeed(value, 0));
+        delayLines.seed(Random::deriveSeed(value, 1));
+        interfaceModule.seed(Random::deriveSeed(value, 2));
+    }
+
+    // Back to the just-constructed state, parameters kept: voice silenced,
+    // buffers and filters cleared, reverb tail dropped, noise reseeded.
+    // Allocation-free, for activate().
+    void resetAll() {
+        isPlaying = false;
+
+        source.reset();
+        envelope.reset();
+        envelope.setGate(false);
+        interfaceModule.resetAll();
+        delayLines.reset();
+        feedback.reset();
+        filter.reset();
+        modulation.reset();
+        reverb.reset();
+        dcBlockerX1 = 0.0f;
+        dcBlockerY1 = 0.0f;
+        prevDelayOutputs = {0.0f, 0.0f};
+        prevFilterOutput = 0.0f;
+        // Last, so the noise streams start where a fresh engine's would.
+        seed(noiseSeed);
+    }
+
+    // Per-sample reference path. processBlock() must stay equivalent to
+    // calling this once per frame.
     float process() {
         if (!isPlaying) {
-            return 0.0f;
+            // The reverb is a bus and rings on after the voice has stopped.
+            return reverb.isIdle() ? 0.0f : reverb.process(0.0f);
         }
 
         const flues::pm::ModulationState modState = modulation.process();
@@ -94,7 +138,7 @@ public:
         prevFilterOutput = filterOutput;
 
         if (!envelope.isPlaying() &&
-            std::abs(output) < 1e-5f &&
+            std::abs(preReverb) < 1e-5f &&
             std::abs(prevDelayOutputs.delay1) < 1e-5f &&
             std::abs(prevDelayOutputs.delay2) < 1e-5f) {
             isPlaying = false;
@@ -103,6 +147,19 @@ public:
         return output;
     }
 
+    // Render `frames` samples. Callers split host buffers at MIDI event
+    // boundaries; the engine further splits into kMaxBlockSize chunks.
+    void processBlock(float* out, uint32_t frames) {
+        FLUES_PROFILE_BEGIN_BLOCK(profiler, frames);
+        while (frames > 0) {
+            const uint32_t n = std::min(frames, kMaxBlockSize);
+            renderSubBlock(out, n);
+            out += n;
+            frames -= n;
+        }
+        FLUES_PROFILE_END_BLOCK(profiler);
+    }
+
     void setAlgorithm(float value) { source.setAlgorithm(value); }
     void setParam1(float value) { source.setParam1(value); }
     void setParam2(float value) { source.setParam2(value); }
@@ -115,6 +172,7 @@ public:
     void setInterfaceIntensity(float value) { interfaceModule.setIntensity(value); }
     void setTuning(float value) { delayLines.setTuning(value); }
     void setRatio(float value) { delayLines.setRatio(value); }
+    void setTuningAndRatio(float tuning, float ratio) { delayLines.setTuningAndRatio(tuning, ratio); }
     void setDelay1Feedback(float value) { feedback.setDelay1Gain(value); }
     void setDelay2Feedback(float value) { feedback.setDelay2Gain(value); }
     void setFilterFeedback(float value) { feedback.setFilterGain(value); }
@@ -125,13 +183,117 @@ public:
     void setModulationTypeLevel(float value) { modulation.setTypeLevel(value); }
     void setReverbSize(float value) { reverb.setSize(value); }
     void setReverbLevel(float value) { reverb.setLevel(value); }
+    void setReverbMode(float value) { reverb.setMode(static_cast<int>(std::round(value))); }
     void setMasterGain(float value) { outputGain = std::clamp(value, 0.0f, 1.0f); }
 
+#if defined(FLUES_PROFILE)
+    flues::pm::Profiler& getProfiler() { return profiler; }
+#endif
+
 private:
+    void renderSubBlock(float* out, uint32_t frames) {
+        if (!isPlaying) {
+            std::fill(out, out + frames, 0.0f);
+            if (!reverb.isIdle()) {
+                FLUES_PROFILE_SCOPE(profiler, Reverb);
+                reverb.processBlock(out, frames);
+            }
+            return;
+        }
+
+        {
+            FLUES_PROFILE_SCOPE(profiler, Modulation);
+            modulation.processBlock(amBuffer.data(), fmBuffer.data(), frames);
+            for (uint32_t i = 0; i < frames; ++i) {
+                fmBuffer[i] *= frequency;
+            }
+        }
+        {
+            FLUES_PROFILE_SCOPE(profiler, Source);
+            source.processBlock(fmBuffer.data(), sourceBuffer.data(), frames);
+        }
+        {
+            FLUES_PROFILE_SCOPE(profiler, Envelope);
+            envelope.processBlock(envBuffer.data(), frames);
+        }
+
+        // Waveguide loop, instantiated per interface strategy. Runs are
+        // capped at the shortest delay so the delays and filter can be
+        // read ahead of the interface (see PMSynthEngine).
+        delayLines.setFrequency(frequency);
+        interfaceModule.dispatch([&](auto& interfaceStage) {
+            uint32_t done = 0;
+            while (done < frames) {
+                const uint32_t n = static_cast<uint32_t>(
+                    std::min<std::size_t>(frames - done, delayLines.readAheadLimit()));
+                float* delay1 = delay1Buffer.data() + done;
+                float* delay2 = delay2Buffer.data() + done;
+                float* filtered = filterBuffer.data() + done;
+                float* delayInput = delayInputBuffer.data() + done;
+
+                {
+                    FLUES_PROFILE_SCOPE(profiler, DelayLines);
+                    delayLines.readBlock(delay1, delay2, n);
+                }
+                {
+                    FLUES_PROFILE_SCOPE(profiler, Filter);
+                    for (uint32_t i = 0; i < n; ++i) {
+                        filtered[i] = (delay1[i] + delay2[i]) * 0.5f;
+                    }
+                    filter.processBlock(filtered, filtered, n);
+                }
+
+                {
+                    FLUES_PROFILE_SCOPE(profiler, Interface);
+                    for (uint32_t i = 0; i < n; ++i) {
+                        const float feedbackSignal = feedback.process(
+                            prevDelayOutputs.delay1,
+                            prevDelayOutputs.delay2,
+                            prevFilterOutput
+                        );
+
+                        const float cleanFeedback = dcBlock(feedbackSignal);
+                        const float interfaceInput = sourceBuffer[done + i] * envBuffer[done + i] + cleanFeedback;
+                        const float interfaceOutput = interfaceStage.process(interfaceInput);
+                        delayInput[i] = std::clamp(interfaceOutput, -1.0f, 1.0f);
+
+                        prevDelayOutputs = {delay1[i], delay2[i]};
+                        prevFilterOutput = filtered[i];
+                    }
+                }
+
+                {
+                    FLUES_PROFILE_SCOPE(profiler, DelayLines);
+                    delayLines.writeBlock(delayInput, n);
+                }
+                done += n;
+            }
+        });
+
+        for (uint32_t i = 0; i < frames; ++i) {
+            out[i] = filterBuffer[i] * amBuffer[i] * outputGain;
+        }
+
+        // Tail detection looks at the dry voice; the reverb tail carries on
+        // after the voice stops.
+        const float lastDry = out[frames - 1];
+        {
+            FLUES_PROFILE_SCOPE(profiler, Reverb);
+            reverb.processBlock(out, frames);
+        }
+
+        if (!envelope.isPlaying() &&
+            std::abs(lastDry) < 1e-5f &&
+            std::abs(prevDelayOutputs.delay1) < 1e-5f &&
+            std::abs(prevDelayOutputs.delay2) < 1e-5f) {
+            isPlaying = false;
+        }
+    }
+
     float dcBlock(float sample) {
         const float y = sample - dcBlockerX1 + 0.995f * dcBlockerY1;
         dcBlockerX1 = sample;
-        dcBlockerY1 = y;
+        dcBlockerY1 = flues::pm::flushDenormal(y);
         return y;
     }
 
@@ -152,6 +314,20 @@ private:
     float dcBlockerY1;
     flues::pm::DelayLinesModule::DelayOutputs prevDelayOutputs;
     float prevFilterOutput;
+    uint32_t noiseSeed;
+
+    std::array<float, kMaxBlockSize> amBuffer{};
+    std::array<float, kMaxBlockSize> fmBuffer{};
+    std::array<float, kMaxBlockSize> sourceBuffer{};
+    std::array<float, kMaxBlockSize> envBuffer{};
+    std::array<float, kMaxBlockSize> delay1Buffer{};
+    std::array<float, kMaxBlockSize> delay2Buffer{};
+    std::array<float, kMaxBlockSize> filterBuffer{};
+    std::array<float, kMaxBlockSize> delayInputBuffer{};
+
+#if defined(FLUES_PROFILE)
+    flues::pm::Profiler profiler;
+#endif
 };
 
 } // namespace flues::floozy
@@ -11,6 +11,8 @@
 #include <lv2/urid/urid.h>
 
 #include "FloozyEngine.hpp"
+#include "../../pm-synth/src/DenormalGuard.hpp"
+#include "../../pm-synth/src/PortCache.hpp"
 
 #define FLOOZY_URI "https://danja.github.io/flues/plugins/floozy"
 #define LOG_PREFIX "[Floozy Plugin] "
@@ -43,9 +45,12 @@ enum PortIndex : uint32_t {
     PORT_REVERB_SIZE,
     PORT_REVERB_LEVEL,
     PORT_MASTER_GAIN,
+    PORT_REVERB_MODE,
     PORT_TOTAL_COUNT
 };
 
+using ControlPorts = flues::pm::PortCache<PORT_TOTAL_COUNT>;
+
 struct FloozyLV2 {
     std::unique_ptr<FloozyEngine> engine;
     float sampleRate;
@@ -53,29 +58,7 @@ struct FloozyLV2 {
     const LV2_Atom_Sequence* midiIn;
     float* audioOut;
 
-    const float* sourceAlgorithm;
-    const float* sourceParam1;
-    const float* sourceParam2;
-    const float* sourceLevel;
-    const float* sourceNoise;
-    const float* sourceDC;
-    const float* envelopeAttack;
-    const float* envelopeRelease;
-    const float* interfaceType;
-    const float* interfaceIntensity;
-    const float* tuning;
-    const float* ratio;
-    const float* delay1Feedback;
-    const float* delay2Feedback;
-    const float* filterFeedback;
-    const float* filterFrequency;
-    const float* filterQ;
-    const float* filterShape;
-    const float* lfoFrequency;
-    const float* modulationTypeLevel;
-    const float* reverbSize;
-    const float* reverbLevel;
-    const float* masterGain;
+    ControlPorts controls;
 
     LV2_URID_Map* map;
     LV2_URID midiEventUrid;
@@ -89,39 +72,45 @@ static void apply_parameters(FloozyLV2* self) {
         return;
     }
 
-    auto apply = [&](const float* port, auto setter) {
-        if (port) {
-            (self->engine.get()->*setter)(*port);
+    const ControlPorts::Mask dirty = self->controls.poll();
+    if (!dirty) {
+        return;
+    }
+
+    auto apply = [&](uint32_t port, auto setter) {
+        if (dirty & ControlPorts::bit(port)) {
+            (self->engine.get()->*setter)(self->controls.value(port));
         }
     };
 
-    apply(self->sourceAlgorithm, &FloozyEngine::setAlgorithm);
-    apply(self->sourceParam1, &FloozyEngine::setParam1);
-    apply(self->sourceParam2, &FloozyEngine::setParam2);
-    apply(self->sourceLevel, &FloozyEngine::setToneLevel);
-    apply(self->sourceNoise, &FloozyEngine::setNoiseLevel);
-    apply(self->sourceDC, &FloozyEngine::setDCLevel);
-    apply(self->envelopeAttack, &FloozyEngine::setAttack);
-    apply(self->envelopeRelease, &FloozyEngine::setRelease);
-
-    if (self->interfaceType) {
-        self->engine->setInterfaceType(*self->interfaceType);
+    apply(PORT_SOURCE_ALGORITHM, &FloozyEngine::setAlgorithm);
+    apply(PORT_SOURCE_PARAM1, &FloozyEngine::setParam1);
+    apply(PORT_SOURCE_PARAM2, &FloozyEngine::setParam2);
+    apply(PORT_SOURCE_LEVEL, &FloozyEngine::setToneLevel);
+    apply(PORT_SOURCE_NOISE, &FloozyEngine::setNoiseLevel);
+    apply(PORT_SOURCE_DC, &FloozyEngine::setDCLevel);
+    apply(PORT_ENVELOPE_ATTACK, &FloozyEngine::setAttack);
+    apply(PORT_ENVELOPE_RELEASE, &FloozyEngine::setRelease);
+
+    apply(PORT_INTERFACE_TYPE, &FloozyEngine::setInterfaceType);
+
+    apply(PORT_INTERFACE_INTENSITY, &FloozyEngine::setInterfaceIntensity);
+    // Tuning and ratio both re-derive the delay lengths; update them together.
+    if (dirty & (ControlPorts::bit(PORT_TUNING) | ControlPorts::bit(PORT_RATIO))) {
+        self->engine->setTuningAndRatio(self->controls.value(PORT_TUNING), self->controls.value(PORT_RATIO));
     }
-
-    apply(self->interfaceIntensity, &FloozyEngine::setInterfaceIntensity);
-    apply(self->tuning, &FloozyEngine::setTuning);
-    apply(self->ratio, &FloozyEngine::setRatio);
-    apply(self->delay1Feedback, &FloozyEngine::setDelay1Feedback);
-    apply(self->delay2Feedback, &FloozyEngine::setDelay2Feedback);
-    apply(self->filterFeedback, &FloozyEngine::setFilterFeedback);
-    apply(self->filterFrequency, &FloozyEngine::setFilterFrequency);
-    apply(self->filterQ, &FloozyEngine::setFilterQ);
-    apply(self->filterShape, &FloozyEngine::setFilterShape);
-    apply(self->lfoFrequency, &FloozyEngine::setLFOFrequency);
-    apply(self->modulationTypeLevel, &FloozyEngine::setModulationTypeLevel);
-    apply(self->reverbSize, &FloozyEngine::setReverbSize);
-    apply(self->reverbLevel, &FloozyEngine::setReverbLevel);
-    apply(self->masterGain, &FloozyEngine::setMasterGain);
+    apply(PORT_DELAY1_FEEDBACK, &FloozyEngine::setDelay1Feedback);
+    apply(PORT_DELAY2_FEEDBACK, &FloozyEngine::setDelay2Feedback);
+    apply(PORT_FILTER_FEEDBACK, &FloozyEngine::setFilterFeedback);
+    apply(PORT_FILTER_FREQUENCY, &FloozyEngine::setFilterFrequency);
+    apply(PORT_FILTER_Q, &FloozyEngine::setFilterQ);
+    apply(PORT_FILTER_SHAPE, &FloozyEngine::setFilterShape);
+    apply(PORT_LFO_FREQUENCY, &FloozyEngine::setLFOFrequency);
+    apply(PORT_MOD_TYPE_LEVEL, &FloozyEngine::setModulationTypeLevel);
+    apply(PORT_REVERB_SIZE, &FloozyEngine::setReverbSize);
+    apply(PORT_REVERB_LEVEL, &FloozyEngine::setReverbLevel);
+    apply(PORT_MASTER_GAIN, &FloozyEngine::setMasterGain);
+    apply(PORT_REVERB_MODE, &FloozyEngine::setReverbMode);
 }
 
 static void handle_midi(FloozyLV2* self, const uint8_t* msg, uint32_t size) {
@@ -181,30 +170,6 @@ static LV2_Handle instantiate(const LV2_Descriptor*, double rate,
     self->midiIn = nullptr;
     self->audioOut = nullptr;
 
-    self->sourceAlgorithm = nullptr;
-    self->sourceParam1 = nullptr;
-    self->sourceParam2 = nullptr;
-    self->sourceLevel = nullptr;
-    self->sourceNoise = nullptr;
-    self->sourceDC = nullptr;
-    self->envelopeAttack = nullptr;
-    self->envelopeRelease = nullptr;
-    self->interfaceType = nullptr;
-    self->interfaceIntensity = nullptr;
-    self->tuning = nullptr;
-    self->ratio = nullptr;
-    self->delay1Feedback = nullptr;
-    self->delay2Feedback = nullptr;
-    self->filterFeedback = nullptr;
-    self->filterFrequency = nullptr;
-    self->filterQ = nullptr;
-    self->filterShape = nullptr;
-    self->lfoFrequency = nullptr;
-    self->modulationTypeLevel = nullptr;
-    self->reverbSize = nullptr;
-    self->reverbLevel = nullptr;
-    self->masterGain = nullptr;
-
     self->map = nullptr;
     self->midiEventUrid = 0;
     self->atomSequenceUrid = 0;
@@ -239,34 +204,18 @@ static void connect_port(LV2_Handle instance, uint32_t port, void* data) {
     switch (port) {
         case PORT_AUDIO_OUT: self->audioOut = static_cast<float*>(data); break;
         case PORT_MIDI_IN: self->midiIn = static_cast<const LV2_Atom_Sequence*>(data); break;
-        case PORT_SOURCE_ALGORITHM: self->sourceAlgorithm = static_cast<const float*>(data); break;
-        case PORT_SOURCE_PARAM1: self->sourceParam1 = static_cast<const float*>(data); break;
-        case PORT_SOURCE_PARAM2: self->sourceParam2 = static_cast<const float*>(data); break;
-        case PORT_SOURCE_LEVEL: self->sourceLevel = static_cast<const float*>(data); break;
-        case PORT_SOURCE_NOISE: self->sourceNoise = static_cast<const float*>(data); break;
-        case PORT_SOURCE_DC: self->sourceDC = static_cast<const float*>(data); break;
-        case PORT_ENVELOPE_ATTACK: self->envelopeAttack = static_cast<const float*>(data); break;
-        case PORT_ENVELOPE_RELEASE: self->envelopeRelease = static_cast<const float*>(data); break;
-        case PORT_INTERFACE_TYPE: self->interfaceType = static_cast<const float*>(data); break;
-        case PORT_INTERFACE_INTENSITY: self->interfaceIntensity = static_cast<const float*>(data); break;
-        case PORT_TUNING: self->tuning = static_cast<const float*>(data); break;
-        case PORT_RATIO: self->ratio = static_cast<const float*>(data); break;
-        case PORT_DELAY1_FEEDBACK: self->delay1Feedback = static_cast<const float*>(data); break;
-        case PORT_DELAY2_FEEDBACK: self->delay2Feedback = static_cast<const float*>(data); break;
-        case PORT_FILTER_FEEDBACK: self->filterFeedback = static_cast<const float*>(data); break;
-        case PORT_FILTER_FREQUENCY: self->filterFrequency = static_cast<const float*>(data); break;
-        case PORT_FILTER_Q: self->filterQ = static_cast<const float*>(data); break;
-        case PORT_FILTER_SHAPE: self->filterShape = static_cast<const float*>(data); break;
-        case PORT_LFO_FREQUENCY: self->lfoFrequency = static_cast<const float*>(data); break;
-        case PORT_MOD_TYPE_LEVEL: self->modulationTypeLevel = static_cast<const float*>(data); break;
-        case PORT_REVERB_SIZE: self->reverbSize = static_cast<const float*>(data); break;
-        case PORT_REVERB_LEVEL: self->reverbLevel = static_cast<const float*>(data); break;
-        case PORT_MASTER_GAIN: self->masterGain = static_cast<const float*>(data); break;
-        default: break;
+        default: self->controls.connect(port, static_cast<const float*>(data)); break;
     }
 }
 
-static void activate(LV2_Handle) {}
+static void activate(LV2_Handle instance) {
+    auto* self = static_cast<flues::floozy::FloozyLV2*>(instance);
+    if (!self || !self->engine) {
+        return;
+    }
+    self->engine->resetAll();
+    self->currentNote = -1;
+}
 
 static void run(LV2_Handle instance, uint32_t n_samples) {
     using namespace flues::floozy;
@@ -275,10 +224,11 @@ static void run(LV2_Handle instance, uint32_t n_samples) {
         return;
     }
 
+    const flues::pm::DenormalGuard denormalGuard;
+
     apply_parameters(self);
 
     float* out = self->audioOut;
-    std::memset(out, 0, n_samples * sizeof(float));
 
     uint32_t frame = 0;
 
@@ -290,9 +240,8 @@ static void run(LV2_Handle instance, uint32_t n_samples) {
 
             if (frame < eventFrame) {
                 const uint32_t limit = std::min(eventFrame, n_samples);
-                for (; frame < limit; ++frame) {
-                    out[frame] = self->engine->process();
-                }
+                self->engine->processBlock(out + frame, limit - frame);
+                frame = limit;
             }
 
             if (ev->body.type == self->midiEventUrid) {
@@ -302,8 +251,8 @@ static void run(LV2_Handle instance, uint32_t n_samples) {
         }
     }
 
-    for (; frame < n_samples; ++frame) {
-        out[frame] = self->engine->process();
+    if (frame < n_samples) {
+        self->engine->processBlock(out + frame, n_samples - frame);
     }
 }
 
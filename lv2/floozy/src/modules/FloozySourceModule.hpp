@@ -1,7 +1,10 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 #include "../../../pm-synth/src/Random.hpp"
 #include "../../../disyn/src/modules/OscillatorModule.hpp"
@@ -10,6 +13,8 @@ namespace flues::floozy {
 
 class FloozySourceModule {
 public:
+    static constexpr std::size_t kNoiseChunk = 64;
+
     explicit FloozySourceModule(float sampleRate = 44100.0f)
         : sampleRate(sampleRate),
           oscillator(sampleRate),
@@ -21,9 +26,14 @@ public:
           dcLevel(0.5f) {}
 
     void reset() {
+        oscillator.setParameters(algorithm, param1, param2);
         oscillator.reset();
     }
 
+    void seed(uint32_t value) {
+        rng.seed(value);
+    }
+
     void setAlgorithm(float value) {
         int index = static_cast<int>(std::round(std::clamp(value, 0.0f, 6.0f)));
         algorithm = static_cast<flues::disyn::AlgorithmType>(index);
@@ -56,6 +66,19 @@ public:
         return osc + noise + dc;
     }
 
+    // Same output as per-sample process(); the oscillator renders the
+    // whole block and the noise is drawn in one fill per chunk.
+    void processBlock(const float* frequency, float* out, std::size_t frames) {
+        oscillator.processBlock(algorithm, param1, param2, frequency, out, frames);
+        for (std::size_t done = 0; done < frames; done += kNoiseChunk) {
+            const std::size_t n = std::min(frames - done, kNoiseChunk);
+            rng.fillSigned(noise.data(), n);
+            for (std::size_t i = 0; i < n; ++i) {
+                out[done + i] = out[done + i] * toneLevel + noise[i] * noiseLevel + dcLevel;
+            }
+        }
+    }
+
 private:
     float sampleRate;
     flues::disyn::OscillatorModule oscillator;
@@ -66,6 +89,7 @@ private:
     float noiseLevel;
     float dcLevel;
     flues::pm::Random rng;
+    std::array<float, kNoiseChunk> noise{};
 };
 
 } // namespace flues::floozy
@@ -56,6 +56,7 @@ typedef enum {
     PORT_REVERB_SIZE,
     PORT_REVERB_LEVEL,
     PORT_MASTER_GAIN,
+    PORT_REVERB_MODE,
     PORT_TOTAL_COUNT
 } PortIndex;
 
@@ -81,6 +82,11 @@ static const char* const kAlgorithmLabels[] = {
     "Modified FM"
 };
 
+static const char* const kReverbModeLabels[] = {
+    "Schroeder",
+    "FDN"
+};
+
 typedef struct {
     GroupIndex group;
     const char* label;
@@ -122,6 +128,7 @@ static const ControlDesc kControlInfo[] = {
 
     { GROUP_REVERB, "SIZE", PORT_REVERB_SIZE, 0.0f, 1.0f, 0.50f, 0, NULL, 0 },
     { GROUP_REVERB, "LEVEL", PORT_REVERB_LEVEL, 0.0f, 1.0f, 0.30f, 0, NULL, 0 },
+    { GROUP_REVERB, "MODE", PORT_REVERB_MODE, 0.0f, 1.0f, 0.0f, 2, kReverbModeLabels, 2 },
 
     { GROUP_OUTPUT, "MASTER", PORT_MASTER_GAIN, 0.0f, 1.0f, 0.80f, 0, NULL, 0 }
 };
@@ -138,7 +145,7 @@ static const GroupLayout kGroupLayout[GROUP_COUNT] = {
     [GROUP_DELAY] = { 2, 4 },
     [GROUP_FILTER] = { 3, 4 },
     [GROUP_MODULATION] = { 4, 2 },
-    [GROUP_REVERB] = { 4, 2 },
+    [GROUP_REVERB] = { 4, 3 },
     [GROUP_OUTPUT] = { 4, 1 }
 };
 
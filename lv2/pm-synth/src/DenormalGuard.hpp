@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+// FLUES_NO_DENORMAL_GUARD builds as if the CPU had no FTZ control, which
+// exercises the flushDenormal() path on x86.
+#if defined(FLUES_NO_DENORMAL_GUARD)
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FLUES_DENORMAL_GUARD_SSE 1
+#elif defined(__aarch64__)
+#define FLUES_DENORMAL_GUARD_AARCH64 1
+#endif
+
+namespace flues::pm {
+
+/**
+ * Flush-to-zero / denormals-are-zero for the lifetime of the object.
+ *
+ * Every filter, comb and follower in the engines decays geometrically
+ * towards zero after a note is released, and its state passes through
+ * the subnormal range on the way; on x86 each operation on a subnormal
+ * can cost a hundred cycles or more. run() opens one guard so the whole
+ * render happens with FTZ (and DAZ on x86) set, and the destructor puts
+ * the host's floating-point mode back.
+ *
+ * The mode is per thread. Where the CPU gives no control over it,
+ * isSupported() is false and flushDenormal() does the work in the
+ * recursive modules instead.
+ */
+class DenormalGuard {
+public:
+    DenormalGuard() : saved(readMode()) {
+        writeMode(saved | kFlushBits);
+    }
+
+    ~DenormalGuard() {
+        writeMode(saved);
+    }
+
+    DenormalGuard(const DenormalGuard&) = delete;
+    DenormalGuard& operator=(const DenormalGuard&) = delete;
+
+    static constexpr bool isSupported() {
+#if defined(FLUES_DENORMAL_GUARD_SSE) || defined(FLUES_DENORMAL_GUARD_AARCH64)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+private:
+#if defined(FLUES_DENORMAL_GUARD_SSE)
+    using Mode = unsigned int;
+    static constexpr Mode kFlushBits = 0x8040u; // MXCSR FTZ | DAZ
+
+    static Mode readMode() { return _mm_getcsr(); }
+    static void writeMode(Mode mode) { _mm_setcsr(mode); }
+#elif defined(FLUES_DENORMAL_GUARD_AARCH64)
+    using Mode = uint64_t;
+    static constexpr Mode kFlushBits = Mode{1} << 24; // FPCR.FZ
+
+    static Mode readMode() {
+        Mode mode;
+        __asm__ __volatile__("mrs %0, fpcr" : "=r"(mode));
+        return mode;
+    }
+    static void writeMode(Mode mode) {
+        __asm__ __volatile__("msr fpcr, %0" : : "r"(mode));
+    }
+#else
+    using Mode = unsigned int;
+    static constexpr Mode kFlushBits = 0u;
+
+    static Mode readMode() { return 0u; }
+    static void writeMode(Mode) {}
+#endif
+
+    Mode saved;
+};
+
+// Zeroes values in the subnormal range on targets DenormalGuard cannot
+// configure; elsewhere the hardware already does this and the call
+// compiles away. Apply it to state that feeds back into itself.
+inline float flushDenormal(float value) {
+    if constexpr (DenormalGuard::isSupported()) {
+        return value;
+    } else {
+        return std::fabs(value) < 1e-30f ? 0.0f : value;
+    }
+}
+
+} // namespace flues::pm
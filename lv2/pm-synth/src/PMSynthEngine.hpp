@@ -1,8 +1,12 @@
 #pragma once
 
-#include <cmath>
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
 
+#include "DenormalGuard.hpp"
+#include "Profiler.hpp"
 #include "modules/SourcesModule.hpp"
 #include "modules/EnvelopeModule.hpp"
 #include "modules/InterfaceModule.hpp"
@@ -16,6 +20,9 @@ namespace flues::pm {
 
 class PMSynthEngine {
 public:
+    // Largest sub-block rendered in one pass; longer host buffers are split.
+    static constexpr uint32_t kMaxBlockSize = 64;
+
     explicit PMSynthEngine(float sampleRate = 44100.0f)
         : sampleRate(sampleRate),
           sources(sampleRate),
@@ -32,7 +39,10 @@ public:
           dcBlockerX1(0.0f),
           dcBlockerY1(0.0f),
           prevDelayOutputs{0.0f, 0.0f},
-          prevFilterOutput(0.0f) {}
+          prevFilterOutput(0.0f),
+          noiseSeed(Random::nextDefaultSeed()) {
+        seed(noiseSeed);
+    }
 
     void noteOn(float freq) {
         frequency = freq;
@@ -47,7 +57,6 @@ public:
         feedback.reset();
         filter.reset();
         modulation.reset();
-        reverb.reset();
         dcBlockerX1 = 0.0f;
         dcBlockerY1 = 0.0f;
         prevDelayOutputs = {0.0f, 0.0f};
@@ -62,9 +71,45 @@ public:
         interfaceModule.setGate(false);
     }
 
+    // Reseeds every noise source so renders are reproducible.
+    void seed(uint32_t value) {
+        noiseSeed = value;
+        sources.seed(Random::deriveSeed(value, 0));
+        delayLines.seed(Random::deriveSeed(value, 1));
+        interfaceModule.seed(Random::deriveSeed(value, 2));
+    }
+
+    // Returns the engine to its just-constructed state without touching
+    // the parameters: voice silenced, every buffer and filter cleared, the
+    // reverb tail dropped and the noise sources reseeded. Nothing is
+    // allocated, so activate() can call this instead of rebuilding.
+    void resetAll() {
+        gate = false;
+        isPlaying = false;
+
+        sources.reset();
+        envelope.reset();
+        envelope.setGate(false);
+        interfaceModule.resetAll();
+        delayLines.reset();
+        feedback.reset();
+        filter.reset();
+        modulation.reset();
+        reverb.reset();
+        dcBlockerX1 = 0.0f;
+        dcBlockerY1 = 0.0f;
+        prevDelayOutputs = {0.0f, 0.0f};
+        prevFilterOutput = 0.0f;
+        // Last, so the noise streams start where a fresh engine's would.
+        seed(noiseSeed);
+    }
+
+    // Per-sample reference path. processBlock() must stay equivalent to
+    // calling this once per frame.
     float process() {
         if (!isPlaying) {
-            return 0.0f;
+            // The reverb is a bus and rings on after the voice has stopped.
+            return reverb.isIdle() ? 0.0f : reverb.process(0.0f);
         }
 
         const ModulationState modState = modulation.process();
@@ -94,7 +139,7 @@ public:
         prevFilterOutput = filterOutput;
 
         if (!envelope.isPlaying() &&
-            std::abs(output) < 1e-5f &&
+            std::abs(preReverbOutput) < 1e-5f &&
             std::abs(prevDelayOutputs.delay1) < 1e-5f &&
             std::abs(prevDelayOutputs.delay2) < 1e-5f) {
             isPlaying = false;
@@ -103,6 +148,19 @@ public:
         return output;
     }
 
+    // Render `frames` samples. Callers split host buffers at MIDI event
+    // boundaries; the engine further splits into kMaxBlockSize chunks.
+    void processBlock(float* out, uint32_t frames) {
+        FLUES_PROFILE_BEGIN_BLOCK(profiler, frames);
+        while (frames > 0) {
+            const uint32_t n = std::min(frames, kMaxBlockSize);
+            renderSubBlock(out, n);
+            out += n;
+            frames -= n;
+        }
+        FLUES_PROFILE_END_BLOCK(profiler);
+    }
+
     // Parameter setters
     void setDCLevel(float value) { sources.setDCLevel(value); }
     void setNoiseLevel(float value) { sources.setNoiseLevel(value); }
@@ -113,6 +171,8 @@ public:
     void setInterfaceIntensity(float value) { interfaceModule.setIntensity(value); }
     void setTuning(float value) { delayLines.setTuning(value); }
     void setRatio(float value) { delayLines.setRatio(value); }
+    void setTuningAndRatio(float tuning, float ratio) { delayLines.setTuningAndRatio(tuning, ratio); }
+    void setDelayInterpolation(float value) { delayLines.setInterpolation(static_cast<int>(std::round(value))); }
     void setDelay1Feedback(float value) { feedback.setDelay1Gain(value); }
     void setDelay2Feedback(float value) { feedback.setDelay2Gain(value); }
     void setFilterFeedback(float value) { feedback.setFilterGain(value); }
@@ -123,14 +183,124 @@ public:
     void setModulationTypeLevel(float value) { modulation.setTypeLevel(value); }
     void setReverbSize(float value) { reverb.setSize(value); }
     void setReverbLevel(float value) { reverb.setLevel(value); }
+    void setReverbMode(float value) { reverb.setMode(static_cast<int>(std::round(value))); }
 
     bool getIsPlaying() const { return isPlaying; }
 
+#if defined(FLUES_PROFILE)
+    // Per-stage timings of processBlock(); drain from a non-RT thread.
+    Profiler& getProfiler() { return profiler; }
+#endif
+
 private:
+    void renderSubBlock(float* out, uint32_t frames) {
+        if (!isPlaying) {
+            std::fill(out, out + frames, 0.0f);
+            if (!reverb.isIdle()) {
+                FLUES_PROFILE_SCOPE(profiler, Reverb);
+                reverb.processBlock(out, frames);
+            }
+            return;
+        }
+
+        // Feed-forward stages have no dependency on the waveguide loop and
+        // run over the whole sub-block.
+        {
+            FLUES_PROFILE_SCOPE(profiler, Modulation);
+            modulation.processBlock(amBuffer.data(), fmBuffer.data(), frames);
+            for (uint32_t i = 0; i < frames; ++i) {
+                fmBuffer[i] *= frequency;
+            }
+        }
+        {
+            FLUES_PROFILE_SCOPE(profiler, Source);
+            sources.processBlock(fmBuffer.data(), sourceBuffer.data(), frames);
+        }
+        {
+            FLUES_PROFILE_SCOPE(profiler, Envelope);
+            envelope.processBlock(envBuffer.data(), frames);
+        }
+
+        // The waveguide is rendered in runs no longer than the shortest
+        // delay, so every delay output in a run depends only on samples
+        // written before it. The delays and filter are read ahead for the
+        // whole run, and the per-sample loop is just feedback -> interface.
+        // The interface type is resolved once here, so that loop is
+        // instantiated per strategy with its process() inlined.
+        delayLines.setFrequency(frequency);
+        interfaceModule.dispatch([&](auto& interfaceStage) {
+            uint32_t done = 0;
+            while (done < frames) {
+                const uint32_t n = static_cast<uint32_t>(
+                    std::min<std::size_t>(frames - done, delayLines.readAheadLimit()));
+                float* delay1 = delay1Buffer.data() + done;
+                float* delay2 = delay2Buffer.data() + done;
+                float* filtered = filterBuffer.data() + done;
+                float* delayInput = delayInputBuffer.data() + done;
+
+                {
+                    FLUES_PROFILE_SCOPE(profiler, DelayLines);
+                    delayLines.readBlock(delay1, delay2, n);
+                }
+                {
+                    FLUES_PROFILE_SCOPE(profiler, Filter);
+                    for (uint32_t i = 0; i < n; ++i) {
+                        filtered[i] = (delay1[i] + delay2[i]) * 0.5f;
+                    }
+                    filter.processBlock(filtered, filtered, n);
+                }
+
+                {
+                    // Feedback, DC blocker and the interface stage.
+                    FLUES_PROFILE_SCOPE(profiler, Interface);
+                    for (uint32_t i = 0; i < n; ++i) {
+                        const float feedbackSignal = feedback.process(
+                            prevDelayOutputs.delay1,
+                            prevDelayOutputs.delay2,
+                            prevFilterOutput
+                        );
+
+                        const float cleanFeedback = dcBlock(feedbackSignal);
+                        const float interfaceInput = sourceBuffer[done + i] * envBuffer[done + i] + cleanFeedback;
+                        const float interfaceOutput = interfaceStage.process(interfaceInput);
+                        delayInput[i] = std::clamp(interfaceOutput, -1.0f, 1.0f);
+
+                        prevDelayOutputs = {delay1[i], delay2[i]};
+                        prevFilterOutput = filtered[i];
+                    }
+                }
+                {
+                    FLUES_PROFILE_SCOPE(profiler, DelayLines);
+                    delayLines.writeBlock(delayInput, n);
+                }
+                done += n;
+            }
+        });
+
+        for (uint32_t i = 0; i < frames; ++i) {
+            out[i] = filterBuffer[i] * amBuffer[i] * outputGain;
+        }
+
+        // Tail detection looks at the dry voice; the reverb tail carries on
+        // after the voice stops.
+        const float lastDry = out[frames - 1];
+        {
+            FLUES_PROFILE_SCOPE(profiler, Reverb);
+            reverb.processBlock(out, frames);
+        }
+
+        if (!envelope.isPlaying() &&
+            std::abs(lastDry) < 1e-5f &&
+            std::abs(prevDelayOutputs.delay1) < 1e-5f &&
+            std::abs(prevDelayOutputs.delay2) < 1e-5f) {
+            isPlaying = false;
+        }
+    }
+
     float dcBlock(float sample) {
         const float y = sample - dcBlockerX1 + 0.995f * dcBlockerY1;
         dcBlockerX1 = sample;
-        dcBlockerY1 = y;
+        dcBlockerY1 = flushDenormal(y);
         return y;
     }
 
@@ -152,6 +322,20 @@ private:
     float dcBlockerY1;
     DelayLinesModule::DelayOutputs prevDelayOutputs;
     float prevFilterOutput;
+    uint32_t noiseSeed;
+
+    std::array<float, kMaxBlockSize> amBuffer{};
+    std::array<float, kMaxBlockSize> fmBuffer{};
+    std::array<float, kMaxBlockSize> sourceBuffer{};
+    std::array<float, kMaxBlockSize> envBuffer{};
+    std::array<float, kMaxBlockSize> delay1Buffer{};
+    std::array<float, kMaxBlockSize> delay2Buffer{};
+    std::array<float, kMaxBlockSize> filterBuffer{};
+    std::array<float, kMaxBlockSize> delayInputBuffer{};
+
+#if defined(FLUES_PROFILE)
+    Profiler profiler;
+#endif
 };
 
 } // namespace flues::pm
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace flues::pm {
+
+/**
+ * Last-applied values of a plugin's control ports.
+ *
+ * run() calls poll() once per cycle and gets back a bitmask of the ports
+ * whose value changed since the previous poll, so only those setters are
+ * dispatched. Several setters map through std::pow or re-derive delay
+ * lengths; with many instances at small buffer sizes, calling all of them
+ * every cycle is measurable. The mask also lets the caller batch setters
+ * that feed the same derived coefficients (see DelayLinesModule::
+ * setTuningAndRatio()).
+ *
+ * Indices are the plugin's LV2 port indices; audio and atom ports are
+ * simply never connected here.
+ */
+template <std::size_t PortCount>
+class PortCache {
+public:
+    using Mask = uint64_t;
+
+    static_assert(PortCount <= 64, "PortCache mask holds at most 64 ports");
+
+    static constexpr Mask bit(uint32_t port) {
+        return Mask{1} << port;
+    }
+
+    // A newly connected port is reported dirty on the next poll().
+    void connect(uint32_t port, const float* data) {
+        if (port < PortCount) {
+            ports[port] = data ? data : &kUnconnected;
+            connected = data ? connected | bit(port) : connected & ~bit(port);
+            pending |= bit(port);
+        }
+    }
+
+    // Reads each port once, latches its value and returns the connected
+    // ports that changed (or were pending). Branch-free over the ports.
+    Mask poll() {
+        Mask dirty = pending;
+        for (uint32_t port = 0; port < PortCount; ++port) {
+            const float value = *ports[port];
+            dirty |= static_cast<Mask>(value != values[port]) << port;
+            values[port] = value;
+        }
+        pending = 0;
+        return dirty & connected;
+    }
+
+    // Value latched by the last poll().
+    float value(uint32_t port) const {
+        return values[port];
+    }
+
+private:
+    static constexpr float kUnconnected = 0.0f;
+
+    std::array<const float*, PortCount> ports = makeUnconnected();
+    std::array<float, PortCount> values{};
+    Mask connected = 0;
+    Mask pending = ~Mask{0};
+
+    static std::array<const float*, PortCount> makeUnconnected() {
+        std::array<const float*, PortCount> unconnected{};
+        unconnected.fill(&kUnconnected);
+        return unconnected;
+    }
+};
+
+} // namespace flues::pm
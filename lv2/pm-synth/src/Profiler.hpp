@@ -0,0 +1,188 @@
+#pragma once
+
+/**
+ * Opt-in per-stage timing for the engines' render paths.
+ *
+ * Build with -DFLUES_PROFILE and each instrumented stage (modulation,
+ * sources, envelope, interface, delay lines, filter, reverb) adds its
+ * elapsed ticks to the current block. At the end of every block the
+ * totals are pushed into a lock-free SPSC ring, which a non-RT thread
+ * (or flues-bench) drains with pop(). When the ring is full the block is
+ * dropped and counted rather than waiting.
+ *
+ * Without FLUES_PROFILE this header only defines the macros, as empty
+ * expansions, and the engines have no profiler member, so the render
+ * paths compile to exactly what they were without instrumentation.
+ */
+
+#if defined(FLUES_PROFILE)
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "SpscRing.hpp"
+
+namespace flues::pm {
+
+enum class ProfileStage : uint8_t {
+    Modulation,
+    Source,
+    Envelope,
+    Interface,
+    DelayLines,
+    Filter,
+    Reverb,
+    Count
+};
+
+inline constexpr std::size_t kProfileStageCount = static_cast<std::size_t>(ProfileStage::Count);
+
+inline const char* profileStageName(std::size_t stage) {
+    static constexpr const char* kNames[kProfileStageCount] = {
+        "modulation", "source", "envelope", "interface", "delayLines", "filter", "reverb"
+    };
+    return stage < kProfileStageCount ? kNames[stage] : "?";
+}
+
+// Time-stamp counter on x86, steady_clock nanoseconds elsewhere.
+inline uint64_t profileNow() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Ticks per second of profileNow(), measured once against steady_clock.
+// Sleeps on first use: not for the audio thread.
+inline double profileTicksPerSecond() {
+    static const double ticksPerSecond = [] {
+        const auto wallStart = std::chrono::steady_clock::now();
+        const uint64_t tickStart = profileNow();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        const uint64_t tickEnd = profileNow();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+        return static_cast<double>(tickEnd - tickStart) / seconds;
+    }();
+    return ticksPerSecond;
+}
+
+// Per-stage ticks for one rendered block. totalTicks spans beginBlock()
+// to endBlock(); the remainder is unattributed work (summing, tail checks,
+// the instrumentation itself).
+struct ProfileBlock {
+    std::array<uint64_t, kProfileStageCount> ticks{};
+    uint64_t totalTicks = 0;
+    uint32_t frames = 0;
+};
+
+class Profiler {
+public:
+    static constexpr std::size_t kRingBlocks = 1024;
+
+    void beginBlock(uint32_t frames) {
+        current.frames = frames;
+        blockStart = profileNow();
+    }
+
+    void add(ProfileStage stage, uint64_t ticks) {
+        current.ticks[static_cast<std::size_t>(stage)] += ticks;
+    }
+
+    void endBlock() {
+        current.totalTicks = profileNow() - blockStart;
+        if (!ring.push(current)) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        current = ProfileBlock{};
+    }
+
+    // Reader side, from one non-RT thread.
+    bool pop(ProfileBlock& block) {
+        return ring.pop(block);
+    }
+
+    uint64_t droppedBlocks() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    ProfileBlock current;
+    uint64_t blockStart = 0;
+    SpscRing<ProfileBlock, kRingBlocks> ring;
+    std::atomic<uint64_t> dropped{0};
+};
+
+class ProfileScope {
+public:
+    ProfileScope(Profiler& profiler, ProfileStage stage)
+        : profiler(profiler), stage(stage), start(profileNow()) {}
+
+    ~ProfileScope() {
+        profiler.add(stage, profileNow() - start);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler& profiler;
+    ProfileStage stage;
+    uint64_t start;
+};
+
+// For per-sample code, where a scope per stage would read the clock twice
+// for every stage: mark() charges the time since the previous mark (or
+// construction) to `stage`, so consecutive stages share one clock read.
+class ProfileLap {
+public:
+    explicit ProfileLap(Profiler& profiler)
+        : profiler(profiler), last(profileNow()) {}
+
+    void mark(ProfileStage stage) {
+        const uint64_t now = profileNow();
+        profiler.add(stage, now - last);
+        last = now;
+    }
+
+    ProfileLap(const ProfileLap&) = delete;
+    ProfileLap& operator=(const ProfileLap&) = delete;
+
+private:
+    Profiler& profiler;
+    uint64_t last;
+};
+
+} // namespace flues::pm
+
+#define FLUES_PROFILE_JOIN_(a, b) a##b
+#define FLUES_PROFILE_JOIN(a, b) FLUES_PROFILE_JOIN_(a, b)
+// Times the rest of the enclosing scope as `stage` (a ProfileStage name).
+#define FLUES_PROFILE_SCOPE(profiler, stage) \
+    const ::flues::pm::ProfileScope FLUES_PROFILE_JOIN(fluesProfileScope, __LINE__)( \
+        (profiler), ::flues::pm::ProfileStage::stage)
+// One lap per scope: FLUES_PROFILE_LAP_BEGIN starts it, each
+// FLUES_PROFILE_LAP(stage) closes the stage that just ran.
+#define FLUES_PROFILE_LAP_BEGIN(profiler) ::flues::pm::ProfileLap fluesProfileLap(profiler)
+#define FLUES_PROFILE_LAP(stage) fluesProfileLap.mark(::flues::pm::ProfileStage::stage)
+#define FLUES_PROFILE_BEGIN_BLOCK(profiler, frames) (profiler).beginBlock(frames)
+#define FLUES_PROFILE_END_BLOCK(profiler) (profiler).endBlock()
+
+#else
+
+#define FLUES_PROFILE_SCOPE(profiler, stage)
+#define FLUES_PROFILE_LAP_BEGIN(profiler)
+#define FLUES_PROFILE_LAP(stage)
+#define FLUES_PROFILE_BEGIN_BLOCK(profiler, frames)
+#define FLUES_PROFILE_END_BLOCK(profiler)
+
+#endif
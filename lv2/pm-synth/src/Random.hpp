@@ -1,38 +1,168 @@
 #pragma once
 
-#include <random>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 
 namespace flues::pm {
 
+// LCG constants plus multipliers/increments that advance the LCG by
+// k + 1 steps, used by Random's block fills.
+struct RandomJumpTable {
+    static constexpr uint32_t kMultiplier = 1664525u;
+    static constexpr uint32_t kIncrement = 1013904223u;
+    static constexpr std::size_t kLanes = 8;
+
+    std::array<uint32_t, kLanes> multiplier{};
+    std::array<uint32_t, kLanes> increment{};
+
+    constexpr RandomJumpTable() {
+        uint32_t mul = 1u;
+        uint32_t inc = 0u;
+        for (std::size_t k = 0; k < kLanes; ++k) {
+            mul = mul * kMultiplier;
+            inc = inc * kMultiplier + kIncrement;
+            multiplier[k] = mul;
+            increment[k] = inc;
+        }
+    }
+};
+
 /**
- * Shared random number generator wrapper.
- * Provides thread-safe (per-instance) uniform and normal variates.
+ * Small-state random number generator for audio-rate noise.
+ *
+ * A 32-bit LCG advanced once per draw, with its state passed through an
+ * integer hash on output (the PCG recipe: cheap transition, strong output
+ * permutation). Construction never touches the OS, so instances can be
+ * created anywhere. Default-constructed instances take distinct seeds from
+ * a process-wide counter; call seed() for reproducible renders.
+ *
+ * fillUniform()/fillSigned() produce exactly the sequence repeated scalar
+ * calls would, but compute eight states at a time from jump-ahead
+ * constants so the loop vectorises.
  */
 class Random {
 public:
     Random()
-        : engine(std::random_device{}()),
-          uniform01(0.0f, 1.0f),
-          uniformSigned(-1.0f, 1.0f),
-          normalDist(0.0f, 1.0f) {}
+        : state(0),
+          spareNormal(0.0f),
+          hasSpareNormal(false) {
+        seed(nextDefaultSeed());
+    }
+
+    explicit Random(uint32_t seedValue)
+        : state(0),
+          spareNormal(0.0f),
+          hasSpareNormal(false) {
+        seed(seedValue);
+    }
+
+    void seed(uint32_t seedValue) {
+        state = hash(seedValue + 0x9E3779B9u);
+        hasSpareNormal = false;
+    }
 
     float uniform() {
-        return uniform01(engine);
+        return toUnit(next());
     }
 
     float uniformSignedFloat() {
-        return uniformSigned(engine);
+        return toSigned(next());
     }
 
     float normal(float mean = 0.0f, float stddev = 1.0f) {
-        return static_cast<float>(normalDist(engine) * stddev + mean);
+        if (hasSpareNormal) {
+            hasSpareNormal = false;
+            return spareNormal * stddev + mean;
+        }
+
+        // Box-Muller; u1 is kept in (0, 1] so the log is finite.
+        const float u1 = static_cast<float>(static_cast<int32_t>(next() >> 8) + 1) * kUnitScale;
+        const float u2 = uniform();
+        const float radius = std::sqrt(-2.0f * std::log(u1));
+        const float theta = 2.0f * static_cast<float>(M_PI) * u2;
+        spareNormal = radius * std::sin(theta);
+        hasSpareNormal = true;
+        return radius * std::cos(theta) * stddev + mean;
+    }
+
+    void fillUniform(float* out, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + kJumpLanes <= count; i += kJumpLanes) {
+            const uint32_t base = state;
+            for (std::size_t lane = 0; lane < kJumpLanes; ++lane) {
+                out[i + lane] = toUnit(hash(kJump.multiplier[lane] * base + kJump.increment[lane]));
+            }
+            state = kJump.multiplier[kJumpLanes - 1] * base + kJump.increment[kJumpLanes - 1];
+        }
+        for (; i < count; ++i) {
+            out[i] = uniform();
+        }
+    }
+
+    void fillSigned(float* out, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + kJumpLanes <= count; i += kJumpLanes) {
+            const uint32_t base = state;
+            for (std::size_t lane = 0; lane < kJumpLanes; ++lane) {
+                out[i + lane] = toSigned(hash(kJump.multiplier[lane] * base + kJump.increment[lane]));
+            }
+            state = kJump.multiplier[kJumpLanes - 1] * base + kJump.increment[kJumpLanes - 1];
+        }
+        for (; i < count; ++i) {
+            out[i] = uniformSignedFloat();
+        }
+    }
+
+    // Decorrelated seed for sub-stream `stream` of a user seed, so one
+    // engine-level seed can fan out to every generator it owns.
+    static uint32_t deriveSeed(uint32_t base, uint32_t stream) {
+        return hash(base ^ ((stream + 1u) * 0x9E3779B9u));
+    }
+
+    static uint32_t nextDefaultSeed() {
+        static std::atomic<uint32_t> counter{0};
+        return deriveSeed(0x5EEDF1E5u, counter.fetch_add(1, std::memory_order_relaxed));
     }
 
 private:
-    std::mt19937 engine;
-    std::uniform_real_distribution<float> uniform01;
-    std::uniform_real_distribution<float> uniformSigned;
-    std::normal_distribution<float> normalDist;
+    static constexpr uint32_t kMultiplier = RandomJumpTable::kMultiplier;
+    static constexpr uint32_t kIncrement = RandomJumpTable::kIncrement;
+    static constexpr std::size_t kJumpLanes = RandomJumpTable::kLanes;
+    static constexpr float kUnitScale = 1.0f / 16777216.0f;
+
+    static constexpr RandomJumpTable kJump{};
+
+    uint32_t next() {
+        state = state * kMultiplier + kIncrement;
+        return hash(state);
+    }
+
+    // lowbias32 integer finaliser.
+    static constexpr uint32_t hash(uint32_t x) {
+        x ^= x >> 16;
+        x *= 0x7FEB352Du;
+        x ^= x >> 15;
+        x *= 0x846CA68Bu;
+        x ^= x >> 16;
+        return x;
+    }
+
+    // Top 24 bits give every float in [0, 1) at 2^-24 spacing; the int32
+    // cast lets the conversion vectorise.
+    static float toUnit(uint32_t bits) {
+        return static_cast<float>(static_cast<int32_t>(bits >> 8)) * kUnitScale;
+    }
+
+    static float toSigned(uint32_t bits) {
+        return static_cast<float>(static_cast<int32_t>(bits >> 8)) * (2.0f * kUnitScale) - 1.0f;
+    }
+
+    uint32_t state;
+    float spareNormal;
+    bool hasSpareNormal;
 };
 
 } // namespace flues::pm
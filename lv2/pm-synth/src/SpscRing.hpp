@@ -0,0 +1,60 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace flues::pm {
+
+/**
+ * Fixed-capacity single-producer / single-consumer ring buffer.
+ *
+ * push() and pop() are wait-free and never allocate, so either end can be
+ * the audio thread. Capacity must be a power of two; one producer and one
+ * consumer thread at a time.
+ */
+template <class T, std::size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>, "SpscRing holds plain values");
+
+public:
+    // Producer side. Returns false, leaving the ring untouched, when full.
+    bool push(const T& item) {
+        const std::size_t write = writeIndex.load(std::memory_order_relaxed);
+        if (write - readIndex.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[write & kMask] = item;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when empty.
+    bool pop(T& item) {
+        const std::size_t read = readIndex.load(std::memory_order_relaxed);
+        if (read == writeIndex.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = slots[read & kMask];
+        readIndex.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Approximate when the other side is active.
+    std::size_t size() const {
+        return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    std::array<T, Capacity> slots{};
+    // Separate cache lines so producer and consumer do not contend.
+    alignas(64) std::atomic<std::size_t> writeIndex{0};
+    alignas(64) std::atomic<std::size_t> readIndex{0};
+};
+
+} // namespace flues::pm
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace flues::pm {
+
+/**
+ * Constant-time note-to-voice bookkeeping for the polyphonic engines.
+ *
+ * Voices are slots 0..voiceCount-1 of the engine's own voice storage. A
+ * 128-entry table maps each MIDI note to the slot sounding it, idle slots
+ * are bits of one 64-bit mask, and busy slots sit on two intrusive queues
+ * in the order they were started or released, so the steal candidate is
+ * always at a queue head. Nothing here scans the voices or allocates.
+ *
+ * An idle slot is always the lowest-numbered one, which keeps sounding
+ * voices packed at the front of the bank (and in as few SIMD lane groups
+ * as possible for floozy-poly).
+ */
+template <std::size_t MaxVoices>
+class VoiceAllocator {
+    static_assert(MaxVoices >= 1 && MaxVoices <= 64, "idle slots are tracked in a 64-bit mask");
+
+public:
+    static constexpr int kNoVoice = -1;
+    static constexpr int kNoteCount = 128;
+
+    explicit VoiceAllocator(std::size_t voiceCount = MaxVoices) {
+        reset(voiceCount);
+    }
+
+    // Every slot idle and every note unmapped. voiceCount is clamped to
+    // 1..MaxVoices.
+    void reset(std::size_t voiceCount) {
+        count = static_cast<uint8_t>(voiceCount < 1 ? 1 : (voiceCount > MaxVoices ? MaxVoices : voiceCount));
+        allSlots = count == 64 ? ~uint64_t{0} : (uint64_t{1} << count) - 1;
+        idleMask = allSlots;
+        noteSlot.fill(kNil);
+        slotNote.fill(kNil);
+        prev.fill(kNil);
+        next.fill(kNil);
+        state.fill(State::Idle);
+        held = Queue{};
+        released = Queue{};
+    }
+
+    std::size_t voiceCount() const { return count; }
+    bool anyActive() const { return held.head != kNil || released.head != kNil; }
+
+    // Bit n is set while slot n is held or releasing. Walking the set bits
+    // visits only the sounding voices, in slot order.
+    uint64_t activeMask() const { return allSlots & ~idleMask; }
+
+    static bool isValidNote(int note) { return note >= 0 && note < kNoteCount; }
+
+    // Slot that should start `note`: the slot already sounding it (a
+    // retrigger), else the lowest idle slot, else a stolen one - the
+    // earliest released voice, or failing that the oldest held one. The
+    // caller restarts the voice in that slot. `note` must be valid.
+    std::size_t noteOn(int note) {
+        uint8_t slot = noteSlot[note];
+        if (slot != kNil) {
+            unlink(queueFor(slot), slot);
+        } else if (idleMask != 0) {
+            slot = static_cast<uint8_t>(__builtin_ctzll(idleMask));
+            idleMask &= idleMask - 1;
+        } else {
+            slot = released.head != kNil ? released.head : held.head;
+            unlink(queueFor(slot), slot);
+            noteSlot[slotNote[slot]] = kNil;
+        }
+
+        noteSlot[note] = slot;
+        slotNote[slot] = static_cast<uint8_t>(note);
+        state[slot] = State::Held;
+        pushBack(held, slot);
+        return slot;
+    }
+
+    // Moves the slot sounding `note` to the released queue and returns it,
+    // or kNoVoice. The note stays mapped until the voice stops or is
+    // stolen, so a repeated note retriggers its own releasing voice.
+    int noteOff(int note) {
+        if (!isValidNote(note) || noteSlot[note] == kNil) {
+            return kNoVoice;
+        }
+        const uint8_t slot = noteSlot[note];
+        if (state[slot] == State::Held) {
+            unlink(held, slot);
+            state[slot] = State::Released;
+            pushBack(released, slot);
+        }
+        return slot;
+    }
+
+    int voiceForNote(int note) const {
+        return isValidNote(note) && noteSlot[note] != kNil ? noteSlot[note] : kNoVoice;
+    }
+
+    // The voice in `slot` has fallen silent; the slot becomes idle.
+    void voiceStopped(std::size_t slot) {
+        const auto s = static_cast<uint8_t>(slot);
+        if (s >= count || state[s] == State::Idle) {
+            return;
+        }
+        unlink(queueFor(s), s);
+        noteSlot[slotNote[s]] = kNil;
+        slotNote[s] = kNil;
+        state[s] = State::Idle;
+        idleMask |= uint64_t{1} << s;
+    }
+
+private:
+    enum class State : uint8_t { Idle, Held, Released };
+
+    static constexpr uint8_t kNil = 0xff;
+
+    struct Queue {
+        uint8_t head = kNil;
+        uint8_t tail = kNil;
+    };
+
+    Queue& queueFor(uint8_t slot) {
+        return state[slot] == State::Held ? held : released;
+    }
+
+    void pushBack(Queue& queue, uint8_t slot) {
+        prev[slot] = queue.tail;
+        next[slot] = kNil;
+        if (queue.tail != kNil) {
+            next[queue.tail] = slot;
+        } else {
+            queue.head = slot;
+        }
+        queue.tail = slot;
+    }
+
+    void unlink(Queue& queue, uint8_t slot) {
+        if (prev[slot] != kNil) {
+            next[prev[slot]] = next[slot];
+        } else {
+            queue.head = next[slot];
+        }
+        if (next[slot] != kNil) {
+            prev[next[slot]] = prev[slot];
+        } else {
+            queue.tail = prev[slot];
+        }
+        prev[slot] = kNil;
+        next[slot] = kNil;
+    }
+
+    std::array<uint8_t, kNoteCount> noteSlot{};
+    std::array<uint8_t, MaxVoices> slotNote{};
+    std::array<uint8_t, MaxVoices> prev{};
+    std::array<uint8_t, MaxVoices> next{};
+    std::array<State, MaxVoices> state{};
+    uint64_t allSlots = 0;
+    uint64_t idleMask = 0;
+    Queue held;
+    Queue released;
+    uint8_t count = 0;
+};
+
+} // namespace flues::pm
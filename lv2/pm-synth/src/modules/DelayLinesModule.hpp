@@ -2,9 +2,11 @@
 
 #include <algorithm>
 #include <cmath>
-#include <vector>
+#include <cstddef>
+#include <cstdint>
 
 #include "../Random.hpp"
+#include "interface/utils/DelayUtils.hpp"
 
 namespace flues::pm {
 
@@ -13,35 +15,47 @@ public:
     explicit DelayLinesModule(float sampleRate = 44100.0f)
         : sampleRate(sampleRate),
           maxDelayLength(static_cast<std::size_t>(sampleRate / 20.0f)),
-          delayLine1(maxDelayLength, 0.0f),
-          delayLine2(maxDelayLength, 0.0f),
-          writePos1(0),
-          writePos2(0),
+          delayLine1(maxDelayLength),
+          delayLine2(maxDelayLength),
           tuningSemitones(0.0f),
           ratio(1.0f),
           delayLength1(1000.0f),
           delayLength2(1000.0f),
-          frequency(440.0f) {}
+          frequency(440.0f),
+          interpolation(DelayInterpolation::LINEAR) {}
 
     void setTuning(float value) {
-        tuningSemitones = (std::clamp(value, 0.0f, 1.0f) - 0.5f) * 24.0f;
+        tuningSemitones = mapTuning(value);
         if (frequency > 0.0f) {
             updateDelayLengths(frequency);
         }
     }
 
     void setRatio(float value) {
-        const float clamped = std::clamp(value, 0.0f, 1.0f);
-        if (clamped < 0.5f) {
-            ratio = 0.5f + clamped;
-        } else {
-            ratio = 1.0f + (clamped - 0.5f) * 2.0f;
+        ratio = mapRatio(value);
+        if (frequency > 0.0f) {
+            updateDelayLengths(frequency);
         }
+    }
+
+    // Both at once, re-deriving the delay lengths a single time.
+    void setTuningAndRatio(float tuning, float ratioValue) {
+        tuningSemitones = mapTuning(tuning);
+        ratio = mapRatio(ratioValue);
         if (frequency > 0.0f) {
             updateDelayLengths(frequency);
         }
     }
 
+    // 0 linear, 1 Hermite, 2 Lagrange (3rd order), 3 Thiran allpass.
+    void setInterpolation(int mode) {
+        interpolation = static_cast<DelayInterpolation>(std::clamp(mode, 0, 3));
+    }
+
+    DelayInterpolation getInterpolation() const {
+        return interpolation;
+    }
+
     void updateDelayLengths(float cv) {
         frequency = cv;
         const float tuningFactor = std::pow(2.0f, tuningSemitones / 12.0f);
@@ -57,61 +71,76 @@ public:
     };
 
     DelayOutputs process(float input, float cv) {
+        setFrequency(cv);
+
+        const float o1 = delayLine1.read(delayLength1, interpolation);
+        const float o2 = delayLine2.read(delayLength2, interpolation);
+
+        delayLine1.write(input);
+        delayLine2.write(input);
+
+        return {o1, o2};
+    }
+
+    void setFrequency(float cv) {
         if (cv != frequency) {
             updateDelayLengths(cv);
         }
+    }
 
-        const float o1 = readDelay(delayLine1, writePos1, delayLength1);
-        const float o2 = readDelay(delayLine2, writePos2, delayLength2);
+    // Block form of process(): readBlock() fills the next `frames` outputs
+    // of both lines, then writeBlock() appends the matching inputs. Valid
+    // while frames <= readAheadLimit(), i.e. no output in the run depends
+    // on an input from the same run.
+    std::size_t readAheadLimit() const {
+        return FractionalDelayLine::readAheadLimit(std::min(delayLength1, delayLength2), interpolation);
+    }
 
-        delayLine1[writePos1] = input;
-        delayLine2[writePos2] = input;
+    void readBlock(float* out1, float* out2, std::size_t frames) {
+        delayLine1.readBlock(out1, frames, delayLength1, delayLength1, interpolation);
+        delayLine2.readBlock(out2, frames, delayLength2, delayLength2, interpolation);
+    }
 
-        writePos1 = (writePos1 + 1) % maxDelayLength;
-        writePos2 = (writePos2 + 1) % maxDelayLength;
+    void writeBlock(const float* input, std::size_t frames) {
+        delayLine1.writeBlock(input, frames);
+        delayLine2.writeBlock(input, frames);
+    }
 
-        return {o1, o2};
+    void seed(uint32_t value) {
+        rng.seed(value);
     }
 
     void reset() {
-        std::fill(delayLine1.begin(), delayLine1.end(), 0.0f);
-        std::fill(delayLine2.begin(), delayLine2.end(), 0.0f);
-        writePos1 = 0;
-        writePos2 = 0;
+        delayLine1.reset();
+        delayLine2.reset();
 
         const std::size_t limit = std::min<std::size_t>(100, maxDelayLength);
         for (std::size_t i = 0; i < limit; ++i) {
-            delayLine1[i] = rng.uniformSignedFloat() * 0.01f;
-            delayLine2[i] = rng.uniformSignedFloat() * 0.01f;
+            delayLine1.setSample(i, rng.uniformSignedFloat() * 0.01f);
+            delayLine2.setSample(i, rng.uniformSignedFloat() * 0.01f);
         }
     }
 
 private:
-    float readDelay(const std::vector<float>& buffer, std::size_t writePos, float delayLength) const {
-        const float readPosFloat = static_cast<float>(writePos) - delayLength;
-        float readPosWrapped = std::fmod(readPosFloat + static_cast<float>(maxDelayLength), static_cast<float>(maxDelayLength));
-        if (readPosWrapped < 0.0f) {
-            readPosWrapped += static_cast<float>(maxDelayLength);
-        }
-
-        const std::size_t readPosInt = static_cast<std::size_t>(std::floor(readPosWrapped));
-        const float frac = readPosWrapped - static_cast<float>(readPosInt);
-        const std::size_t nextPos = (readPosInt + 1) % maxDelayLength;
+    static float mapTuning(float value) {
+        return (std::clamp(value, 0.0f, 1.0f) - 0.5f) * 24.0f;
+    }
 
-        return buffer[readPosInt] * (1.0f - frac) + buffer[nextPos] * frac;
+    static float mapRatio(float value) {
+        const float clamped = std::clamp(value, 0.0f, 1.0f);
+        return clamped < 0.5f ? 0.5f + clamped : 1.0f + (clamped - 0.5f) * 2.0f;
     }
 
     float sampleRate;
     std::size_t maxDelayLength;
-    std::vector<float> delayLine1;
-    std::vector<float> delayLine2;
-    std::size_t writePos1;
-    std::size_t writePos2;
+    FractionalDelayLine delayLine1;
+    FractionalDelayLine delayLine2;
     float tuningSemitones;
     float ratio;
     float delayLength1;
     float delayLength2;
     float frequency;
+    DelayInterpolation interpolation;
     Random rng;
 };
 
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 
 namespace flues::pm {
 
@@ -34,15 +35,23 @@ public:
         }
     }
 
+    float getAttackIncrement() const {
+        return 1.0f / (attackTime * sampleRate);
+    }
+
+    float getReleaseIncrement() const {
+        return 1.0f / (releaseTime * sampleRate);
+    }
+
     float process() {
         if (gate) {
-            const float attackRate = 1.0f / (attackTime * sampleRate);
+            const float attackRate = getAttackIncrement();
             envelope += attackRate;
             if (envelope > 1.0f) {
                 envelope = 1.0f;
             }
         } else {
-            const float releaseRate = 1.0f / (releaseTime * sampleRate);
+            const float releaseRate = getReleaseIncrement();
             envelope -= releaseRate;
             if (envelope < 0.0f) {
                 envelope = 0.0f;
@@ -52,6 +61,12 @@ public:
         return envelope;
     }
 
+    void processBlock(float* out, std::size_t frames) {
+        for (std::size_t i = 0; i < frames; ++i) {
+            out[i] = process();
+        }
+    }
+
     bool isPlaying() const {
         return isActive;
     }
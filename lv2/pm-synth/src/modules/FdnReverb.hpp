@@ -0,0 +1,239 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "../DenormalGuard.hpp"
+
+#if defined(__SSE2__) && !defined(FLUES_FDN_SCALAR)
+#include <xmmintrin.h>
+#define FLUES_FDN_SSE 1
+#endif
+
+namespace flues::pm {
+
+/**
+ * Eight-line feedback delay network.
+ *
+ * All lines live in one 32-byte aligned allocation. Each recirculating
+ * sample passes a one-pole damping lowpass and a per-line decay gain, then
+ * an 8x8 Hadamard matrix (a fast Walsh-Hadamard transform: three butterfly
+ * stages, two SSE registers wide when available).
+ *
+ * Every line is longer than kMaxBlock, so processBlock() reads a whole
+ * block from each line before writing any of it back. The matrix then
+ * runs over a frame-major scratch buffer, one 8-lane vector per frame.
+ */
+class FdnReverb {
+public:
+    static constexpr std::size_t kLines = 8;
+    static constexpr std::size_t kMaxBlock = 64;
+
+    explicit FdnReverb(float sampleRate = 44100.0f)
+        : sampleRate(sampleRate),
+          decaySeconds(0.0f) {
+        // Mutually prime lengths spread between 23 and 67 ms at 44.1 kHz.
+        static constexpr std::array<std::size_t, kLines> kBaseLengths{
+            1021, 1237, 1453, 1669, 1877, 2113, 2477, 2953
+        };
+
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < kLines; ++i) {
+            const float scaled = static_cast<float>(kBaseLengths[i]) * sampleRate / 44100.0f;
+            lengths[i] = std::max<std::size_t>(static_cast<std::size_t>(scaled), kMaxBlock + 1);
+            offsets[i] = total;
+            // Keep each line's start on a vector boundary.
+            total += (lengths[i] + kBlockFloats - 1) / kBlockFloats * kBlockFloats;
+        }
+        storage.resize(total / kBlockFloats);
+
+        positions.fill(0);
+        damped.fill(0.0f);
+        gains.fill(0.0f);
+        setSize(0.5f);
+    }
+
+    // Maps size 0..1 onto a 0.3..6 s decay time.
+    void setSize(float value) {
+        const float seconds = 0.3f + std::clamp(value, 0.0f, 1.0f) * 5.7f;
+        if (seconds == decaySeconds) {
+            return;
+        }
+        decaySeconds = seconds;
+        for (std::size_t i = 0; i < kLines; ++i) {
+            const float lineSeconds = static_cast<float>(lengths[i]) / sampleRate;
+            // -60 dB after decaySeconds; the Hadamard normalisation is folded in.
+            gains[i] = std::pow(10.0f, -3.0f * lineSeconds / decaySeconds) * kHadamardScale;
+        }
+    }
+
+    // Writes the wet signal for `frames` input samples (frames <= kMaxBlock).
+    void processBlock(const float* input, float* wet, std::size_t frames) {
+        for (std::size_t line = 0; line < kLines; ++line) {
+            gatherLine(line, frames);
+        }
+
+        for (std::size_t t = 0; t < frames; ++t) {
+            wet[t] = mixFrame(&scratch[t * kLines], input[t]);
+        }
+
+        for (std::size_t line = 0; line < kLines; ++line) {
+            scatterLine(line, frames);
+        }
+    }
+
+    // Samples before anything still in the network reaches the output.
+    std::size_t tailFrames() const {
+        return *std::max_element(lengths.begin(), lengths.end());
+    }
+
+    void reset() {
+        for (auto& block : storage) {
+            std::fill(std::begin(block.v), std::end(block.v), 0.0f);
+        }
+        positions.fill(0);
+        damped.fill(0.0f);
+    }
+
+private:
+    static constexpr std::size_t kBlockFloats = 8;
+    static constexpr float kDamping = 0.3f;
+    static constexpr float kInputGain = 0.5f;
+    static constexpr float kOutputGain = 0.85f;
+    static constexpr float kHadamardScale = 0.35355339f;  // 1 / sqrt(8)
+
+    struct alignas(32) AlignedBlock {
+        float v[kBlockFloats];
+    };
+
+    float* lineData(std::size_t line) {
+        return reinterpret_cast<float*>(storage.data()) + offsets[line];
+    }
+
+    // Copies the next `frames` outputs of `line` into column `line` of the
+    // frame-major scratch buffer.
+    void gatherLine(std::size_t line, std::size_t frames) {
+        const float* data = lineData(line);
+        const std::size_t pos = positions[line];
+        const std::size_t first = std::min(frames, lengths[line] - pos);
+        for (std::size_t t = 0; t < first; ++t) {
+            scratch[t * kLines + line] = data[pos + t];
+        }
+        for (std::size_t t = first; t < frames; ++t) {
+            scratch[t * kLines + line] = data[t - first];
+        }
+    }
+
+    // Writes column `line` of the scratch buffer back into the line and
+    // advances it.
+    void scatterLine(std::size_t line, std::size_t frames) {
+        float* data = lineData(line);
+        const std::size_t pos = positions[line];
+        const std::size_t first = std::min(frames, lengths[line] - pos);
+        for (std::size_t t = 0; t < first; ++t) {
+            data[pos + t] = scratch[t * kLines + line];
+        }
+        for (std::size_t t = first; t < frames; ++t) {
+            data[t - first] = scratch[t * kLines + line];
+        }
+        positions[line] = first < frames ? frames - first : pos + frames;
+        if (positions[line] == lengths[line]) {
+            positions[line] = 0;
+        }
+    }
+
+    // One frame: damp the line outputs, sum them into the wet output, then
+    // replace them in place with the next line inputs.
+    float mixFrame(float* frame, float input) {
+#if defined(FLUES_FDN_SSE)
+        const __m128 keep = _mm_set1_ps(kDamping);
+        const __m128 take = _mm_set1_ps(1.0f - kDamping);
+        __m128 a = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(frame), take),
+                              _mm_mul_ps(_mm_loadu_ps(damped.data()), keep));
+        __m128 b = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(frame + 4), take),
+                              _mm_mul_ps(_mm_loadu_ps(damped.data() + 4), keep));
+        if constexpr (!DenormalGuard::isSupported()) {
+            const __m128 floor = _mm_set1_ps(1e-30f);
+            const __m128 sign = _mm_set1_ps(-0.0f);
+            a = _mm_and_ps(a, _mm_cmpge_ps(_mm_andnot_ps(sign, a), floor));
+            b = _mm_and_ps(b, _mm_cmpge_ps(_mm_andnot_ps(sign, b), floor));
+        }
+        _mm_storeu_ps(damped.data(), a);
+        _mm_storeu_ps(damped.data() + 4, b);
+
+        // Wet output: alternating-sign tap sum for a decorrelated mono mix.
+        const __m128 signs = _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f);
+        __m128 tap = _mm_mul_ps(_mm_add_ps(a, b), signs);
+        tap = _mm_add_ps(tap, _mm_movehl_ps(tap, tap));
+        tap = _mm_add_ss(tap, _mm_shuffle_ps(tap, tap, 1));
+        const float output = _mm_cvtss_f32(tap) * kOutputGain;
+
+        a = _mm_mul_ps(a, _mm_loadu_ps(gains.data()));
+        b = _mm_mul_ps(b, _mm_loadu_ps(gains.data() + 4));
+
+        // Stage 1: lines i and i + 4.
+        const __m128 sum = _mm_add_ps(a, b);
+        const __m128 diff = _mm_sub_ps(a, b);
+        a = hadamard4(sum);
+        b = hadamard4(diff);
+
+        const __m128 in = _mm_set1_ps(input * kInputGain);
+        _mm_storeu_ps(frame, _mm_add_ps(a, in));
+        _mm_storeu_ps(frame + 4, _mm_add_ps(b, in));
+        return output;
+#else
+        float x[kLines];
+        float output = 0.0f;
+        for (std::size_t i = 0; i < kLines; ++i) {
+            damped[i] = flushDenormal(frame[i] * (1.0f - kDamping) + damped[i] * kDamping);
+            output += (i & 1) ? -damped[i] : damped[i];
+            x[i] = damped[i] * gains[i];
+        }
+
+        for (std::size_t half = kLines / 2; half > 0; half /= 2) {
+            for (std::size_t i = 0; i < kLines; i += 2 * half) {
+                for (std::size_t j = i; j < i + half; ++j) {
+                    const float u = x[j];
+                    const float v = x[j + half];
+                    x[j] = u + v;
+                    x[j + half] = u - v;
+                }
+            }
+        }
+
+        const float in = input * kInputGain;
+        for (std::size_t i = 0; i < kLines; ++i) {
+            frame[i] = x[i] + in;
+        }
+        return output * kOutputGain;
+#endif
+    }
+
+#if defined(FLUES_FDN_SSE)
+    // Stages 2 and 3 within one register: [x0 x1 x2 x3] ->
+    // [x0+x1+x2+x3, x0-x1+x2-x3, x0+x1-x2-x3, x0-x1-x2+x3].
+    static __m128 hadamard4(__m128 x) {
+        const __m128 lo = _mm_movelh_ps(x, x);
+        const __m128 hi = _mm_movehl_ps(x, x);
+        const __m128 r = _mm_add_ps(lo, _mm_mul_ps(hi, _mm_setr_ps(1.0f, 1.0f, -1.0f, -1.0f)));
+        const __m128 even = _mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 odd = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 1, 1));
+        return _mm_add_ps(even, _mm_mul_ps(odd, _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f)));
+    }
+#endif
+
+    float sampleRate;
+    float decaySeconds;
+    std::array<std::size_t, kLines> lengths{};
+    std::array<std::size_t, kLines> offsets{};
+    std::array<std::size_t, kLines> positions{};
+    std::array<float, kLines> damped{};
+    std::array<float, kLines> gains{};
+    std::vector<AlignedBlock> storage;
+    std::array<float, kMaxBlock * kLines> scratch{};
+};
+
+} // namespace flues::pm
@@ -23,6 +23,18 @@ public:
         filterGain = std::clamp(value, 0.0f, 1.0f) * 0.99f;
     }
 
+    float getDelay1Gain() const {
+        return delay1Gain;
+    }
+
+    float getDelay2Gain() const {
+        return delay2Gain;
+    }
+
+    float getFilterGain() const {
+        return filterGain;
+    }
+
     float process(float delay1Output, float delay2Output, float filterOutput) const {
         return delay1Output * delay1Gain +
                delay2Output * delay2Gain +
@@ -2,72 +2,184 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+
+#include "../DenormalGuard.hpp"
 
 namespace flues::pm {
 
+// Coefficients of the trapezoidal (TPT) state-variable filter: g is the
+// prewarped cutoff tan(pi * fc / fs), k the damping 1/Q, and a1..a3 the
+// derived terms that make the per-sample update division-free.
+struct SvfCoefficients {
+    float g;
+    float k;
+    float a1;
+    float a2;
+    float a3;
+
+    static SvfCoefficients make(float g, float k) {
+        const float a1 = 1.0f / (1.0f + g * (g + k));
+        const float a2 = g * a1;
+        return {g, k, a1, a2, g * a2};
+    }
+};
+
+/**
+ * Zero-delay-feedback state-variable filter (Simper / Zavalishin TPT form),
+ * stable up to Nyquist unlike the Chamberlin form it replaces.
+ *
+ * Setters only recompute the cutoff and damping targets, and only when
+ * the value changes. The filter glides to them with a per-sample one-pole
+ * (kSmoothingSeconds), so ports can be swept without zipper noise. Once
+ * the glide has settled, the cached a1..a3 are reused and a sample costs
+ * a handful of multiply-adds.
+ */
 class FilterModule {
 public:
+    static constexpr float kSmoothingSeconds = 0.005f;
+
     explicit FilterModule(float sampleRate = 44100.0f)
         : sampleRate(sampleRate),
           frequency(1000.0f),
           q(1.0f),
           shape(0.0f),
-          low(0.0f),
-          band(0.0f),
-          high(0.0f) {}
+          smoothing(1.0f - std::exp(-1.0f / (kSmoothingSeconds * sampleRate))),
+          targetG(prewarp(frequency)),
+          targetK(dampingFor(q)),
+          current(SvfCoefficients::make(targetG, targetK)),
+          settled(true),
+          ic1eq(0.0f),
+          ic2eq(0.0f) {}
 
     void setFrequency(float value) {
         const float clamped = std::clamp(value, 0.0f, 1.0f);
-        frequency = 20.0f * std::pow(1000.0f, clamped);
+        const float next = 20.0f * std::pow(1000.0f, clamped);
+        if (next != frequency) {
+            frequency = next;
+            targetG = prewarp(frequency);
+            settled = false;
+        }
     }
 
     void setQ(float value) {
         const float clamped = std::clamp(value, 0.0f, 1.0f);
-        q = 0.5f * std::pow(40.0f, clamped);
+        const float next = 0.5f * std::pow(40.0f, clamped);
+        if (next != q) {
+            q = next;
+            targetK = dampingFor(q);
+            settled = false;
+        }
     }
 
     void setShape(float value) {
         shape = std::clamp(value, 0.0f, 1.0f);
     }
 
-    float process(float input) {
-        const float f = 2.0f * std::sin(static_cast<float>(M_PI) * frequency / sampleRate);
-        const float qInv = 1.0f / std::max(0.5f, q);
+    // Current (smoothed) coefficients.
+    const SvfCoefficients& getCoefficients() const {
+        return current;
+    }
 
-        low += f * band;
-        high = input - low - qInv * band;
-        band = f * high + band;
+    float getShape() const {
+        return shape;
+    }
 
-        if (!std::isfinite(low)) low = 0.0f;
-        if (!std::isfinite(band)) band = 0.0f;
-        if (!std::isfinite(high)) high = 0.0f;
+    bool isSettled() const {
+        return settled;
+    }
 
-        float output = 0.0f;
-        if (shape < 0.5f) {
-            const float mix = shape * 2.0f;
-            output = low * (1.0f - mix) + band * mix;
-        } else {
-            const float mix = (shape - 0.5f) * 2.0f;
-            output = band * (1.0f - mix) + high * mix;
+    // Moves the glide on by `frames` samples without filtering anything,
+    // for callers that run the filter arithmetic themselves at block rate.
+    void advance(std::size_t frames) {
+        if (settled) {
+            return;
         }
+        const float decay = std::pow(1.0f - smoothing, static_cast<float>(frames));
+        glideTo(targetG + (current.g - targetG) * decay,
+                targetK + (current.k - targetK) * decay);
+    }
 
+    float process(float input) {
+        float output;
+        processBlock(&input, &output, 1);
         return output;
     }
 
+    void processBlock(const float* input, float* output, std::size_t frames) {
+        std::size_t i = 0;
+        for (; i < frames && !settled; ++i) {
+            glideTo(current.g + (targetG - current.g) * smoothing,
+                    current.k + (targetK - current.k) * smoothing);
+            output[i] = tick(input[i], current);
+        }
+        for (; i < frames; ++i) {
+            output[i] = tick(input[i], current);
+        }
+    }
+
+    // Clears the state and jumps to the targets.
     void reset() {
-        low = 0.0f;
-        band = 0.0f;
-        high = 0.0f;
+        ic1eq = 0.0f;
+        ic2eq = 0.0f;
+        current = SvfCoefficients::make(targetG, targetK);
+        settled = true;
     }
 
 private:
+    float prewarp(float cutoff) const {
+        const float limited = std::min(cutoff, sampleRate * 0.49f);
+        return std::tan(static_cast<float>(M_PI) * limited / sampleRate);
+    }
+
+    static float dampingFor(float resonance) {
+        return 1.0f / std::max(0.5f, resonance);
+    }
+
+    void glideTo(float g, float k) {
+        if (std::abs(g - targetG) <= targetG * 1e-5f && std::abs(k - targetK) <= targetK * 1e-5f) {
+            g = targetG;
+            k = targetK;
+            settled = true;
+        }
+        current = SvfCoefficients::make(g, k);
+    }
+
+    float tick(float input, const SvfCoefficients& c) {
+        const float v3 = input - ic2eq;
+        const float v1 = c.a1 * ic1eq + c.a2 * v3;
+        const float v2 = ic2eq + c.a2 * ic1eq + c.a3 * v3;
+        ic1eq = 2.0f * v1 - ic1eq;
+        ic2eq = 2.0f * v2 - ic2eq;
+
+        if (!std::isfinite(ic1eq)) ic1eq = 0.0f;
+        if (!std::isfinite(ic2eq)) ic2eq = 0.0f;
+        ic1eq = flushDenormal(ic1eq);
+        ic2eq = flushDenormal(ic2eq);
+
+        const float low = v2;
+        const float band = v1;
+        const float high = input - c.k * v1 - v2;
+
+        if (shape < 0.5f) {
+            const float mix = shape * 2.0f;
+            return low * (1.0f - mix) + band * mix;
+        }
+        const float mix = (shape - 0.5f) * 2.0f;
+        return band * (1.0f - mix) + high * mix;
+    }
+
     float sampleRate;
     float frequency;
     float q;
     float shape;
-    float low;
-    float band;
-    float high;
+    float smoothing;
+    float targetG;
+    float targetK;
+    SvfCoefficients current;
+    bool settled;
+    float ic1eq;
+    float ic2eq;
 };
 
 } // namespace flues::pm
@@ -1,71 +1,169 @@
 #pragma once
 
-#include <memory>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 
 #include "interface/InterfaceFactory.hpp"
+#include "interface/InterfaceStrategyPool.hpp"
 
 namespace flues::pm {
 
 class InterfaceModule {
 public:
+    // Length of the linear crossfade applied when the type changes.
+    static constexpr float kCrossfadeSeconds = 0.005f;
+
     explicit InterfaceModule(float sampleRate = 44100.0f)
-        : sampleRate(sampleRate),
+        : pool(sampleRate),
           currentType(InterfaceType::REED),
-          strategy(InterfaceFactory::createStrategy(currentType, sampleRate)),
-          gateState(false) {}
+          previousType(InterfaceType::REED),
+          pendingType(InterfaceType::REED),
+          crossfadeLength(std::max(1, static_cast<int>(sampleRate * kCrossfadeSeconds))),
+          crossfadeRemaining(0),
+          gateState(false),
+          rngSeed(Random::nextDefaultSeed()) {
+        pool.seed(rngSeed);
+    }
 
+    // Switching only changes which pooled strategy is active; nothing is
+    // allocated. The incoming strategy starts from its reset state, as a
+    // freshly created one would, and the outgoing one keeps running until
+    // the crossfade completes. A change that arrives during a crossfade is
+    // held until that one finishes (the latest wins), so the mix never
+    // jumps and a strategy is never reset while it is still audible.
     void setType(int typeValue) {
         if (!InterfaceFactory::isValidType(typeValue)) {
             return;
         }
 
         const InterfaceType type = static_cast<InterfaceType>(typeValue);
-        if (type != currentType) {
-            const float oldIntensity = strategy->getIntensity();
-            currentType = type;
-            strategy = InterfaceFactory::createStrategy(currentType, sampleRate);
-            strategy->setIntensity(oldIntensity);
-            strategy->setGate(gateState);
+        pendingType = type;
+        if (crossfadeRemaining == 0 && type != currentType) {
+            beginCrossfade(type);
         }
     }
 
     void setIntensity(float value) {
-        strategy->setIntensity(value);
+        pool.get(currentType).setIntensity(value);
     }
 
     float process(float input) {
-        return strategy->process(input);
+        const float output = processActive(input);
+        if (crossfadeRemaining == 0) {
+            return output;
+        }
+
+        const float outgoing = pool.visit(previousType, [input](auto& strategy) {
+            return strategy.process(input);
+        });
+        const float fade = static_cast<float>(crossfadeRemaining) / static_cast<float>(crossfadeLength);
+        --crossfadeRemaining;
+        if (crossfadeRemaining == 0 && pendingType != currentType) {
+            // The outgoing strategy is silent from the next sample on.
+            beginCrossfade(pendingType);
+        }
+        return output + (outgoing - output) * fade;
+    }
+
+    void processBlock(const float* input, float* output, std::size_t frames) {
+        if (crossfadeRemaining > 0) {
+            for (std::size_t i = 0; i < frames; ++i) {
+                output[i] = process(input[i]);
+            }
+            return;
+        }
+        pool.visit(currentType, [&](auto& strategy) {
+            strategy.processBlock(input, output, frames);
+        });
+    }
+
+    // Calls fn once with the active strategy as its concrete type, so a
+    // per-sample loop written inside fn is compiled once per strategy with
+    // process() inlined. Hoist this outside the sample loop. While a type
+    // crossfade is running fn receives the module itself, whose process()
+    // blends both strategies.
+    template <class Fn>
+    void dispatch(Fn&& fn) {
+        if (crossfadeRemaining > 0) {
+            fn(*this);
+            return;
+        }
+        pool.visit(currentType, fn);
     }
 
     void setGate(bool gate) {
         gateState = gate;
-        strategy->setGate(gateState);
+        pool.get(currentType).setGate(gateState);
+    }
+
+    // Seeds every pooled strategy's noise source.
+    void seed(uint32_t value) {
+        rngSeed = value;
+        pool.seed(rngSeed);
     }
 
     void reset() {
-        strategy->reset();
+        crossfadeRemaining = 0;
+        pendingType = currentType;
+        InterfaceStrategy& strategy = pool.get(currentType);
+        strategy.reset();
         if (gateState) {
-            strategy->setGate(true);
+            strategy.setGate(true);
         }
     }
 
+    // reset() for the whole pool: every strategy is cleared and reseeded
+    // and the gate is closed, as after construction. Allocation-free.
+    void resetAll() {
+        crossfadeRemaining = 0;
+        previousType = currentType;
+        pendingType = currentType;
+        gateState = false;
+        pool.seed(rngSeed);
+        pool.resetAll();
+    }
+
     InterfaceType getType() const {
         return currentType;
     }
 
     float getIntensity() const {
-        return strategy->getIntensity();
+        return pool.get(currentType).getIntensity();
     }
 
     const char* getStrategyName() const {
-        return strategy->getName();
+        return pool.get(currentType).getName();
     }
 
 private:
-    float sampleRate;
+    void beginCrossfade(InterfaceType type) {
+        const float oldIntensity = pool.get(currentType).getIntensity();
+        InterfaceStrategy& incoming = pool.get(type);
+        incoming.reset();
+        incoming.setIntensity(oldIntensity);
+        incoming.setGate(false);
+        incoming.setGate(gateState);
+
+        previousType = currentType;
+        currentType = type;
+        crossfadeRemaining = crossfadeLength;
+    }
+
+    float processActive(float input) {
+        return pool.visit(currentType, [input](auto& strategy) {
+            return strategy.process(input);
+        });
+    }
+
+    InterfaceStrategyPool pool;
     InterfaceType currentType;
-    std::unique_ptr<InterfaceStrategy> strategy;
+    InterfaceType previousType;
+    InterfaceType pendingType;  // Latest requested type, applied after a crossfade
+    int crossfadeLength;
+    int crossfadeRemaining;
     bool gateState;
+    uint32_t rngSeed;
 };
 
 } // namespace flues::pm
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 
 namespace flues::pm {
 
@@ -37,8 +38,20 @@ public:
         }
     }
 
+    float getPhaseIncrement() const {
+        return (lfoFrequency * 2.0f * static_cast<float>(M_PI)) / sampleRate;
+    }
+
+    float getAmDepth() const {
+        return amDepth;
+    }
+
+    float getFmDepth() const {
+        return fmDepth;
+    }
+
     ModulationState process() {
-        const float phaseIncrement = (lfoFrequency * 2.0f * static_cast<float>(M_PI)) / sampleRate;
+        const float phaseIncrement = getPhaseIncrement();
         lfoPhase += phaseIncrement;
         if (lfoPhase > 2.0f * static_cast<float>(M_PI)) {
             lfoPhase -= 2.0f * static_cast<float>(M_PI);
@@ -51,6 +64,14 @@ public:
         return {lfo, am, fm};
     }
 
+    void processBlock(float* amOut, float* fmOut, std::size_t frames) {
+        for (std::size_t i = 0; i < frames; ++i) {
+            const ModulationState state = process();
+            amOut[i] = state.am;
+            fmOut[i] = state.fm;
+        }
+    }
+
     void reset() {
         lfoPhase = 0.0f;
     }
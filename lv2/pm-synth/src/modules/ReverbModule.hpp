@@ -1,17 +1,42 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <vector>
 #include <array>
 
+#include "../DenormalGuard.hpp"
+#include "FdnReverb.hpp"
+
 namespace flues::pm {
 
+enum class ReverbMode : int {
+    SCHROEDER = 0,
+    FDN
+};
+
+/**
+ * Reverb send bus: engines feed it continuously and it keeps ringing across
+ * notes, so it is not reset on note on. Two networks are available:
+ * the original Schroeder design (four combs, two allpasses) and an
+ * eight-line FdnReverb with a denser tail.
+ *
+ * Once both the input and the wet output have stayed below
+ * kSilenceThreshold for longer than the longest path through the network,
+ * every buffer has decayed below the threshold and the module goes idle:
+ * processBlock() then only applies the dry gain. Any input above the
+ * threshold wakes it again.
+ */
 class ReverbModule {
 public:
+    static constexpr float kSilenceThreshold = 1e-6f;
+
     explicit ReverbModule(float sampleRate = 44100.0f)
         : sampleRate(sampleRate),
           size(0.5f),
           level(0.3f),
+          mode(ReverbMode::SCHROEDER),
           combDelays{
               static_cast<std::size_t>(0.0297f * sampleRate),
               static_cast<std::size_t>(0.0371f * sampleRate),
@@ -33,10 +58,24 @@ public:
               std::vector<float>(allpassDelays[0], 0.0f),
               std::vector<float>(allpassDelays[1], 0.0f)
           },
-          allpassIndices{0, 0} {}
+          allpassIndices{0, 0},
+          fdn(sampleRate),
+          tailFrames(std::max(combDelays[3] + allpassDelays[0] + allpassDelays[1], fdn.tailFrames())),
+          quietFrames(0),
+          idle(true) {}
 
     void setSize(float value) {
         size = std::clamp(value, 0.0f, 1.0f);
+        fdn.setSize(size);
+    }
+
+    // 0 Schroeder, 1 FDN. Switching clears both networks.
+    void setMode(int value) {
+        const ReverbMode next = static_cast<ReverbMode>(std::clamp(value, 0, 1));
+        if (next != mode) {
+            mode = next;
+            reset();
+        }
     }
 
     void setLevel(float value) {
@@ -44,38 +83,54 @@ public:
     }
 
     float process(float input) {
-        float combSum = 0.0f;
-        const float feedback = 0.7f + size * 0.28f;
-
-        for (std::size_t i = 0; i < combBuffers.size(); ++i) {
-            auto& buffer = combBuffers[i];
-            const std::size_t index = combIndices[i];
-            const std::size_t delay = combDelays[i];
-
-            const float delayed = buffer[index];
-            buffer[index] = input + delayed * feedback;
-            combSum += delayed;
+        processBlock(&input, 1);
+        return input;
+    }
 
-            combIndices[i] = (index + 1) % delay;
+    void processBlock(float* buffer, std::size_t frames) {
+        const float dry = 1.0f - level;
+        if (idle) {
+            // Quiet samples ahead of the wake-up bypass the network, exactly
+            // as they would one call at a time.
+            std::size_t quiet = 0;
+            while (quiet < frames && std::abs(buffer[quiet]) < kSilenceThreshold) {
+                buffer[quiet++] *= dry;
+            }
+            if (quiet == frames) {
+                return;
+            }
+            buffer += quiet;
+            frames -= quiet;
+            idle = false;
+            quietFrames = 0;
         }
 
-        float output = combSum / static_cast<float>(combBuffers.size());
+        for (std::size_t done = 0; done < frames; done += FdnReverb::kMaxBlock) {
+            const std::size_t n = std::min(frames - done, FdnReverb::kMaxBlock);
+            float* chunk = buffer + done;
 
-        for (std::size_t i = 0; i < allpassBuffers.size(); ++i) {
-            auto& buffer = allpassBuffers[i];
-            const std::size_t index = allpassIndices[i];
-            const std::size_t delay = allpassDelays[i];
+            if (mode == ReverbMode::FDN) {
+                fdn.processBlock(chunk, wet.data(), n);
+            } else {
+                processSchroeder(chunk, n);
+            }
 
-            const float delayed = buffer[index];
-            const float g = 0.5f;
-            const float newOutput = -output * g + delayed;
-            buffer[index] = output + delayed * g;
-            output = newOutput;
+            for (std::size_t i = 0; i < n; ++i) {
+                const float input = chunk[i];
+                chunk[i] = input * dry + wet[i] * level;
 
-            allpassIndices[i] = (index + 1) % delay;
+                const bool quiet = std::max(std::abs(input), std::abs(wet[i])) < kSilenceThreshold;
+                quietFrames = quiet ? quietFrames + 1 : 0;
+            }
         }
 
-        return input * (1.0f - level) + output * level;
+        if (quietFrames > tailFrames) {
+            idle = true;
+        }
+    }
+
+    bool isIdle() const {
+        return idle;
     }
 
     void reset() {
@@ -87,12 +142,72 @@ public:
         }
         std::fill(combIndices.begin(), combIndices.end(), 0);
         std::fill(allpassIndices.begin(), allpassIndices.end(), 0);
+        fdn.reset();
+        quietFrames = 0;
+        idle = true;
     }
 
 private:
+    // Schroeder wet path for one chunk, into wet[]. Each comb and then each
+    // allpass runs over the whole chunk in turn, which gives the same
+    // result as stepping them all a sample at a time: the combs are
+    // parallel, and every allpass only needs the previous one's output for
+    // the same sample.
+    void processSchroeder(const float* input, std::size_t frames) {
+        const float feedback = 0.7f + size * 0.28f;
+        std::fill(wet.begin(), wet.begin() + frames, 0.0f);
+
+        for (std::size_t c = 0; c < combBuffers.size(); ++c) {
+            float* buffer = combBuffers[c].data();
+            std::size_t index = combIndices[c];
+            for (std::size_t done = 0; done < frames;) {
+                // Up to the wrap point the indices are contiguous.
+                const std::size_t span = std::min(frames - done, combDelays[c] - index);
+                for (std::size_t i = 0; i < span; ++i) {
+                    const float delayed = buffer[index + i];
+                    buffer[index + i] = flushDenormal(input[done + i] + delayed * feedback);
+                    wet[done + i] += delayed;
+                }
+                done += span;
+                index += span;
+                if (index == combDelays[c]) {
+                    index = 0;
+                }
+            }
+            combIndices[c] = index;
+        }
+
+        const float combScale = 1.0f / static_cast<float>(combBuffers.size());
+        for (std::size_t i = 0; i < frames; ++i) {
+            wet[i] *= combScale;
+        }
+
+        const float g = 0.5f;
+        for (std::size_t a = 0; a < allpassBuffers.size(); ++a) {
+            float* buffer = allpassBuffers[a].data();
+            std::size_t index = allpassIndices[a];
+            for (std::size_t done = 0; done < frames;) {
+                const std::size_t span = std::min(frames - done, allpassDelays[a] - index);
+                for (std::size_t i = 0; i < span; ++i) {
+                    const float delayed = buffer[index + i];
+                    const float x = wet[done + i];
+                    buffer[index + i] = flushDenormal(x + delayed * g);
+                    wet[done + i] = -x * g + delayed;
+                }
+                done += span;
+                index += span;
+                if (index == allpassDelays[a]) {
+                    index = 0;
+                }
+            }
+            allpassIndices[a] = index;
+        }
+    }
+
     float sampleRate;
     float size;
     float level;
+    ReverbMode mode;
 
     std::array<std::size_t, 4> combDelays;
     std::array<std::size_t, 2> allpassDelays;
@@ -100,6 +215,11 @@ private:
     std::array<std::size_t, 4> combIndices;
     std::array<std::vector<float>, 2> allpassBuffers;
     std::array<std::size_t, 2> allpassIndices;
+    FdnReverb fdn;
+    std::array<float, FdnReverb::kMaxBlock> wet{};
+    std::size_t tailFrames;
+    std::size_t quietFrames;
+    bool idle;
 };
 
 } // namespace flues::pm
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 
 #include "../Random.hpp"
 
@@ -29,10 +31,32 @@ public:
     }
 
     float process(float cv) {
+        return render(cv, rng.uniformSignedFloat());
+    }
+
+    // Same output as calling process() per sample: the noise for the whole
+    // block is drawn up front with the vectorised fill.
+    void processBlock(const float* cv, float* out, std::size_t frames) {
+        rng.fillSigned(out, frames);
+        for (std::size_t i = 0; i < frames; ++i) {
+            out[i] = render(cv[i], out[i]);
+        }
+    }
+
+    void seed(uint32_t value) {
+        rng.seed(value);
+    }
+
+    void reset() {
+        sawtoothPhase = 0.0f;
+    }
+
+private:
+    float render(float cv, float white) {
         sawtoothFrequency = cv;
 
         const float dc = dcLevel;
-        const float noise = rng.uniformSignedFloat() * noiseLevel;
+        const float noise = white * noiseLevel;
 
         const float phaseIncrement = sawtoothFrequency / sampleRate;
         sawtoothPhase += phaseIncrement;
@@ -44,11 +68,6 @@ public:
         return dc + noise + saw;
     }
 
-    void reset() {
-        sawtoothPhase = 0.0f;
-    }
-
-private:
     float sampleRate;
     float dcLevel;
     float noiseLevel;
@@ -2,6 +2,10 @@
 
 #include <stdexcept>
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "../../Random.hpp"
 
 namespace flues::pm {
 
@@ -51,6 +55,10 @@ public:
         return intensity;
     }
 
+    void seed(uint32_t value) {
+        rng.seed(value);
+    }
+
     virtual const char* getName() const {
         return "InterfaceStrategy";
     }
@@ -60,6 +68,22 @@ protected:
     float intensity;
     bool gate;
     bool previousGate;
+    Random rng;  // noise for strategies that need it; seeded via InterfaceModule
+};
+
+// Base for the concrete strategies. Strategies are final, so the call to
+// process() below resolves statically and inlines into the block loop.
+template <class Derived>
+class BlockInterfaceStrategy : public InterfaceStrategy {
+public:
+    using InterfaceStrategy::InterfaceStrategy;
+
+    void processBlock(const float* input, float* output, std::size_t frames) {
+        Derived& self = static_cast<Derived&>(*this);
+        for (std::size_t i = 0; i < frames; ++i) {
+            output[i] = self.process(input[i]);
+        }
+    }
 };
 
 } // namespace flues::pm
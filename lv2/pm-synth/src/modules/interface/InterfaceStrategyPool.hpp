@@ -0,0 +1,111 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "InterfaceStrategy.hpp"
+#include "strategies/PluckStrategy.hpp"
+#include "strategies/HitStrategy.hpp"
+#include "strategies/ReedStrategy.hpp"
+#include "strategies/FluteStrategy.hpp"
+#include "strategies/BrassStrategy.hpp"
+#include "strategies/BowStrategy.hpp"
+#include "strategies/BellStrategy.hpp"
+#include "strategies/DrumStrategy.hpp"
+#include "strategies/CrystalStrategy.hpp"
+#include "strategies/VaporStrategy.hpp"
+#include "strategies/PlasmaStrategy.hpp"
+#include "strategies/QuantumStrategy.hpp"
+
+namespace flues::pm {
+
+/**
+ * One instance of every interface strategy, constructed up front so that
+ * changing the interface type never allocates. get() returns the strategy
+ * through its virtual base; visit() hands the concrete type to a callable,
+ * so code inside it calls process() directly and can be inlined.
+ */
+class InterfaceStrategyPool {
+public:
+    static constexpr std::size_t kSize = static_cast<std::size_t>(InterfaceType::PLASMA) + 1;
+
+    explicit InterfaceStrategyPool(float sampleRate = 44100.0f)
+        : pluck(sampleRate),
+          hit(sampleRate),
+          reed(sampleRate),
+          flute(sampleRate),
+          brass(sampleRate),
+          bow(sampleRate),
+          bell(sampleRate),
+          drum(sampleRate),
+          crystal(sampleRate),
+          vapor(sampleRate),
+          quantum(sampleRate),
+          plasma(sampleRate),
+          table{&pluck, &hit, &reed, &flute, &brass, &bow,
+                &bell, &drum, &crystal, &vapor, &quantum, &plasma} {}
+
+    // The table points into this object.
+    InterfaceStrategyPool(const InterfaceStrategyPool&) = delete;
+    InterfaceStrategyPool& operator=(const InterfaceStrategyPool&) = delete;
+
+    InterfaceStrategy& get(InterfaceType type) {
+        return *table[static_cast<std::size_t>(type)];
+    }
+
+    const InterfaceStrategy& get(InterfaceType type) const {
+        return *table[static_cast<std::size_t>(type)];
+    }
+
+    // Switch-based equivalent of std::visit over the 12 strategy types.
+    template <class Fn>
+    decltype(auto) visit(InterfaceType type, Fn&& fn) {
+        switch (type) {
+            case InterfaceType::PLUCK:   return fn(pluck);
+            case InterfaceType::HIT:     return fn(hit);
+            case InterfaceType::REED:    return fn(reed);
+            case InterfaceType::FLUTE:   return fn(flute);
+            case InterfaceType::BRASS:   return fn(brass);
+            case InterfaceType::BOW:     return fn(bow);
+            case InterfaceType::BELL:    return fn(bell);
+            case InterfaceType::DRUM:    return fn(drum);
+            case InterfaceType::CRYSTAL: return fn(crystal);
+            case InterfaceType::VAPOR:   return fn(vapor);
+            case InterfaceType::QUANTUM: return fn(quantum);
+            case InterfaceType::PLASMA:
+            default:                     return fn(plasma);
+        }
+    }
+
+    void seed(uint32_t value) {
+        for (std::size_t i = 0; i < kSize; ++i) {
+            table[i]->seed(Random::deriveSeed(value, static_cast<uint32_t>(i)));
+        }
+    }
+
+    // Every strategy back to its reset state with the gate closed.
+    void resetAll() {
+        for (InterfaceStrategy* strategy : table) {
+            strategy->reset();
+            strategy->setGate(false);
+        }
+    }
+
+private:
+    PluckStrategy pluck;
+    HitStrategy hit;
+    ReedStrategy reed;
+    FluteStrategy flute;
+    BrassStrategy brass;
+    BowStrategy bow;
+    BellStrategy bell;
+    DrumStrategy drum;
+    CrystalStrategy crystal;
+    VaporStrategy vapor;
+    QuantumStrategy quantum;
+    PlasmaStrategy plasma;
+    std::array<InterfaceStrategy*, kSize> table;
+};
+
+} // namespace flues::pm
@@ -7,10 +7,10 @@
 
 namespace flues::pm {
 
-class BellStrategy : public InterfaceStrategy {
+class BellStrategy final : public BlockInterfaceStrategy<BellStrategy> {
 public:
     explicit BellStrategy(float sampleRate)
-        : InterfaceStrategy(sampleRate),
+        : BlockInterfaceStrategy(sampleRate),
           bellPhase(0.0f) {}
 
     float process(float input) override {
@@ -3,24 +3,25 @@
 #include "../InterfaceStrategy.hpp"
 #include "../utils/NonlinearityLib.hpp"
 #include "../utils/ExcitationGen.hpp"
+#include "../../../DenormalGuard.hpp"
 #include <algorithm>
 
 namespace flues::pm {
 
-class BowStrategy : public InterfaceStrategy {
+class BowStrategy final : public BlockInterfaceStrategy<BowStrategy> {
 public:
     explicit BowStrategy(float sampleRate)
-        : InterfaceStrategy(sampleRate),
+        : BlockInterfaceStrategy(sampleRate),
           bowState(0.0f) {}
 
     float process(float input) override {
         const float bowVelocity = intensity * 0.9f + 0.2f;
         const float slip = input - bowState;
         const float friction = fastTanh(slip * (6.0f + intensity * 12.0f));
-        const float grit = whiteNoise(intensity * 0.012f, &rng);
+        const float grit = whiteNoise(rng, intensity * 0.012f);
         const float output = friction * (0.55f + intensity * 0.35f) + slip * 0.25f + grit;
         const float stick = 0.8f - intensity * 0.25f;
-        bowState = bowState * stick + (input + friction * bowVelocity * 0.05f) * (1.0f - stick);
+        bowState = flushDenormal(bowState * stick + (input + friction * bowVelocity * 0.05f) * (1.0f - stick));
         return std::clamp(output, -1.0f, 1.0f);
     }
 
@@ -38,7 +39,6 @@ public:
 
 private:
     float bowState;
-    Random rng;
 };
 
 } // namespace flues::pm
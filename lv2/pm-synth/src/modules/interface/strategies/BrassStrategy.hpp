@@ -6,10 +6,10 @@
 
 namespace flues::pm {
 
-class BrassStrategy : public InterfaceStrategy {
+class BrassStrategy final : public BlockInterfaceStrategy<BrassStrategy> {
 public:
     explicit BrassStrategy(float sampleRate)
-        : InterfaceStrategy(sampleRate) {}
+        : BlockInterfaceStrategy(sampleRate) {}
 
     float process(float input) override {
         const float drive = 1.5f + intensity * 5.0f;
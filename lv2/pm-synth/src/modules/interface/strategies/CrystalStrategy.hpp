@@ -2,22 +2,23 @@
 
 #include "../InterfaceStrategy.hpp"
 #include "../utils/NonlinearityLib.hpp"
+#include "../../../DenormalGuard.hpp"
 #include <algorithm>
 
 namespace flues::pm {
 
-class CrystalStrategy : public InterfaceStrategy {
+class CrystalStrategy final : public BlockInterfaceStrategy<CrystalStrategy> {
 public:
     explicit CrystalStrategy(float sampleRate)
-        : InterfaceStrategy(sampleRate),
+        : BlockInterfaceStrategy(sampleRate),
           phase1(0.0f),
           phase2(0.0f),
           phase3(0.0f) {}
 
     float process(float input) override {
-        phase1 = phase1 * 0.98f + input;
-        phase2 = phase2 * 0.95f + input * kPhi;
-        phase3 = phase3 * 0.92f + input * kPhi2;
+        phase1 = flushDenormal(phase1 * 0.98f + input);
+        phase2 = flushDenormal(phase2 * 0.95f + input * kPhi);
+        phase3 = flushDenormal(phase3 * 0.92f + input * kPhi2);
 
         const float p1 = input * (1.0f + phase1 * 0.3f);
         const float p2 = input * (1.0f + phase2 * 0.3f);
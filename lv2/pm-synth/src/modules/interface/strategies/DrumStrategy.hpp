@@ -3,22 +3,23 @@
 #include "../InterfaceStrategy.hpp"
 #include "../utils/ExcitationGen.hpp"
 #include "../utils/NonlinearityLib.hpp"
+#include "../../../DenormalGuard.hpp"
 #include <algorithm>
 
 namespace flues::pm {
 
-class DrumStrategy : public InterfaceStrategy {
+class DrumStrategy final : public BlockInterfaceStrategy<DrumStrategy> {
 public:
     explicit DrumStrategy(float sampleRate)
-        : InterfaceStrategy(sampleRate),
+        : BlockInterfaceStrategy(sampleRate),
           drumEnergy(0.0f) {}
 
     float process(float input) override {
         const float drive = 1.2f + intensity * 2.2f;
-        const float noise = whiteNoise(0.02f + intensity * 0.06f, &rng);
+        const float noise = whiteNoise(rng, 0.02f + intensity * 0.06f);
 
-        drumEnergy = drumEnergy * (0.7f - intensity * 0.2f) +
-                     std::abs(input) * (0.6f + intensity * 0.7f);
+        drumEnergy = flushDenormal(drumEnergy * (0.7f - intensity * 0.2f) +
+                                   std::abs(input) * (0.6f + intensity * 0.7f));
 
         const float hit = std::tanh(input * drive) + noise;
         const float output = hit * (0.4f + intensity * 0.4f) +
@@ -41,7 +42,6 @@ public:
 
 private:
     float drumEnergy;
-    Random rng;
 };
 
 } // namespace flues::pm
@@ -6,15 +6,15 @@
 
 namespace flues::pm {
 
-class FluteStrategy : public InterfaceStrategy {
+class FluteStrategy final : public BlockInterfaceStrategy<FluteStrategy> {
 public:
     explicit FluteStrategy(float sampleRate)
-        : InterfaceStrategy(sampleRate) {}
+        : BlockInterfaceStrategy(sampleRate) {}
 
     float process(float input) override {
         const float softness = 0.45f + intensity * 0.4f;
         const float gateFactor = gate ? 1.0f : 0.0f;
-        const float breath = whiteNoise(intensity * 0.04f * gateFactor, &rng);
+        const float breath = whiteNoise(rng, intensity * 0.04f * gateFactor);
         const float mixed = (input + breath) * softness;
         const float shaped = mixed - (mixed * mixed * mixed) * 0.35f;
         return std::clamp(shaped, -0.49f, 0.49f);
@@ -25,9 +25,6 @@ public:
     const char* getName() const override {
         return "FluteStrategy";
     }
-
-private:
-    Random rng;
 };
 
 } // namespace flues::pm
@@ -7,10 +7,10 @@
 
 namespace flues::pm {
 
-class HitStrategy : public InterfaceStrategy {
+class HitStrategy final : public BlockInterfaceStrategy<HitStrategy> {
 public:
     explicit HitStrategy(float sampleRate)
-        : InterfaceStrategy(sampleRate) {}
+        : BlockInterfaceStrategy(sampleRate) {}
 
     float process(float input) override {
         const float drive = 2.0f + intensity * 8.0f;
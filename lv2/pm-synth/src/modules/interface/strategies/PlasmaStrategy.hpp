@@ -3,14 +3,15 @@
 #include "../InterfaceStrategy.hpp"
 #include "../utils/EnergyTracker.hpp"
 #include "../utils/NonlinearityLib.hpp"
+#include "../../../DenormalGuard.hpp"
 #include <algorithm>
 
 namespace flues::pm {
 
-class PlasmaStrategy : public InterfaceStrategy {
+class PlasmaStrategy final : public BlockInterfaceStrategy<PlasmaStrategy> {
 public:
     explicit PlasmaStrategy(float sampleRate)
-        : InterfaceStrategy(sampleRate),
+        : BlockInterfaceStrategy(sampleRate),
           ampTracker(0.001f, sampleRate),
           phase(0.0f),
           x1(0.0f),
@@ -31,7 +32,7 @@ public:
         const float dispersed = allpassCoeff * input + x1 - allpassCoeff * y1;
 
         x1 = input;
-        y1 = dispersed;
+        y1 = flushDenormal(dispersed);
 
         float output = dispersed + freqMod;
         if (intensity > 0.5f) {
@@ -1,15 +1,16 @@
 #pragma once
 
 #include "../InterfaceStrategy.hpp"
+#include "../../../DenormalGuard.hpp"
 #include <algorithm>
 #include <cmath>
 
 namespace flues::pm {
 
-class PluckStrategy : public InterfaceStrategy {
+class PluckStrategy final : public BlockInterfaceStrategy<PluckStrategy> {
 public:
     explicit PluckStrategy(float sampleRate)
-        : InterfaceStrategy(sampleRate),
+        : BlockInterfaceStrategy(sampleRate),
           lastPeak(0.0f),
           peakDecay(0.999f),
           prevInput(0.0f) {}
@@ -22,7 +23,7 @@ public:
             lastPeak = input;
             response = input;
         } else {
-            lastPeak *= peakDecay;
+            lastPeak = flushDenormal(lastPeak * peakDecay);
             const float transient = (input - prevInput) * brightness;
             const float damp = 0.35f + (1.0f - intensity) * 0.45f;
             response = input * damp + transient;
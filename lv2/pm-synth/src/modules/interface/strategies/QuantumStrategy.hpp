@@ -8,10 +8,10 @@
 
 namespace flues::pm {
 
-class QuantumStrategy : public InterfaceStrategy {
+class QuantumStrategy final : public BlockInterfaceStrategy<QuantumStrategy> {
 public:
     explicit QuantumStrategy(float sampleRate)
-        : InterfaceStrategy(sampleRate) {}
+        : BlockInterfaceStrategy(sampleRate) {}
 
     float process(float input) override {
         const int bitDepth = 8 - static_cast<int>(std::floor(intensity * 5.0f));
@@ -23,7 +23,7 @@ public:
         const float nearBoundary = std::abs(scaled - std::round(scaled));
         float boundaryNoise = 0.0f;
         if (nearBoundary > 0.45f) {
-            boundaryNoise = whiteNoise(0.01f * intensity, &rng);
+            boundaryNoise = whiteNoise(rng, 0.01f * intensity);
         }
 
         const float output = quantized + boundaryNoise;
@@ -35,9 +35,6 @@ public:
     const char* getName() const override {
         return "QuantumStrategy";
     }
-
-private:
-    Random rng;
 };
 
 } // namespace flues::pm
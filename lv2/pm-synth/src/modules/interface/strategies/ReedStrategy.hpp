@@ -5,10 +5,10 @@
 
 namespace flues::pm {
 
-class ReedStrategy : public InterfaceStrategy {
+class ReedStrategy final : public BlockInterfaceStrategy<ReedStrategy> {
 public:
     explicit ReedStrategy(float sampleRate)
-        : InterfaceStrategy(sampleRate) {}
+        : BlockInterfaceStrategy(sampleRate) {}
 
     float process(float input) override {
         const float stiffness = 2.5f + intensity * 10.0f;
@@ -7,10 +7,10 @@
 
 namespace flues::pm {
 
-class VaporStrategy : public InterfaceStrategy {
+class VaporStrategy final : public BlockInterfaceStrategy<VaporStrategy> {
 public:
     explicit VaporStrategy(float sampleRate)
-        : InterfaceStrategy(sampleRate),
+        : BlockInterfaceStrategy(sampleRate),
           chaos1(3.7f),
           chaos2(3.8f),
           chaos3(3.9f),
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <vector>
 #include <limits>
 
@@ -28,6 +29,18 @@ inline float cubicInterpolate(float xm1, float x0, float x1, float x2, float fra
     return ((a0 * frac + a1) * frac + a2) * frac + a3;
 }
 
+// Third-order Lagrange through four equally spaced points; frac is the
+// position between x0 and x1.
+inline float lagrangeInterpolate(float xm1, float x0, float x1, float x2, float frac) {
+    const float dm1 = frac + 1.0f;
+    const float d1 = frac - 1.0f;
+    const float d2 = frac - 2.0f;
+    return -xm1 * (frac * d1 * d2) * (1.0f / 6.0f) +
+           x0 * (dm1 * d1 * d2) * 0.5f -
+           x1 * (dm1 * frac * d2) * 0.5f +
+           x2 * (dm1 * frac * d1) * (1.0f / 6.0f);
+}
+
 inline float allpassCoefficient(float delay) {
     return (1.0f - delay) / (1.0f + delay);
 }
@@ -54,50 +67,138 @@ private:
     float y1;
 };
 
+enum class DelayInterpolation : int {
+    LINEAR = 0,
+    HERMITE,
+    LAGRANGE,
+    ALLPASS
+};
+
+inline std::size_t nextPowerOfTwo(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/**
+ * Ring buffer with fractional-delay reads.
+ *
+ * The ring is rounded up to a power of two so wrapping is a mask, and the
+ * first kGuard samples are mirrored past its end so an interpolator can read
+ * up to four consecutive samples without wrapping or branching.
+ *
+ * Reads are relative to the next write position: a delay of d returns the
+ * sample written d writes ago. readBlock() returns a run of outputs
+ * before any of them are written back. It is valid while the run is no
+ * longer than readAheadLimit() for the shortest delay in it.
+ *
+ * The allpass read is a first-order Thiran interpolator: an integer read of
+ * round(d) - 1 samples followed by an allpass supplying the remaining 0.5..1.5
+ * samples. It is flat in magnitude, unlike the polynomial modes, but has
+ * state, so call it exactly once per output sample.
+ */
 class FractionalDelayLine {
 public:
+    static constexpr std::size_t kGuard = 4;
+
     explicit FractionalDelayLine(std::size_t maxLength)
-        : buffer(maxLength, 0.0f),
-          maxLength(maxLength),
-          writePos(0) {}
+        : maxLength(maxLength),
+          capacity(nextPowerOfTwo(std::max<std::size_t>(maxLength, kGuard))),
+          mask(capacity - 1),
+          buffer(capacity + kGuard, 0.0f),
+          writePos(0),
+          allpassDelta(1.0f),
+          allpassEta(0.0f) {}
 
     void write(float sample) {
         buffer[writePos] = sample;
-        writePos = (writePos + 1) % maxLength;
+        buffer[writePos + (writePos < kGuard ? capacity : 0)] = sample;
+        writePos = (writePos + 1) & mask;
     }
 
-    float readLinear(float delayLength) const {
-        const float readPosFloat = static_cast<float>(writePos) - delayLength;
-        float readPosWrapped = std::fmod(readPosFloat + static_cast<float>(maxLength), static_cast<float>(maxLength));
-        if (readPosWrapped < 0.0f) {
-            readPosWrapped += static_cast<float>(maxLength);
+    void writeBlock(const float* input, std::size_t frames) {
+        for (std::size_t i = 0; i < frames; ++i) {
+            write(input[i]);
         }
-        const std::size_t readPosInt = static_cast<std::size_t>(std::floor(readPosWrapped));
-        const float frac = readPosWrapped - static_cast<float>(readPosInt);
-        const std::size_t nextPos = (readPosInt + 1) % maxLength;
-        return lerp(buffer[readPosInt], buffer[nextPos], frac);
+    }
+
+    float readLinear(float delayLength) const {
+        return tapLinear(delayLength, 0);
     }
 
     float readHermite(float delayLength) const {
-        const float readPosFloat = static_cast<float>(writePos) - delayLength;
-        float readPosWrapped = std::fmod(readPosFloat + static_cast<float>(maxLength), static_cast<float>(maxLength));
-        if (readPosWrapped < 0.0f) {
-            readPosWrapped += static_cast<float>(maxLength);
+        return tapHermite(delayLength, 0);
+    }
+
+    float readLagrange(float delayLength) const {
+        return tapLagrange(delayLength, 0);
+    }
+
+    float readAllpass(float delayLength) {
+        return tapAllpass(delayLength, 0);
+    }
+
+    float read(float delayLength, DelayInterpolation mode) {
+        switch (mode) {
+            case DelayInterpolation::HERMITE:  return readHermite(delayLength);
+            case DelayInterpolation::LAGRANGE: return readLagrange(delayLength);
+            case DelayInterpolation::ALLPASS:  return readAllpass(delayLength);
+            case DelayInterpolation::LINEAR:
+            default:                           return readLinear(delayLength);
         }
-        const std::size_t readPosInt = static_cast<std::size_t>(std::floor(readPosWrapped));
-        const float frac = readPosWrapped - static_cast<float>(readPosInt);
+    }
 
-        const std::size_t pos0 = readPosInt % maxLength;
-        const std::size_t posm1 = (pos0 + maxLength - 1) % maxLength;
-        const std::size_t pos1 = (pos0 + 1) % maxLength;
-        const std::size_t pos2 = (pos0 + 2) % maxLength;
+    // `frames` consecutive outputs while the delay moves linearly from
+    // startDelay to endDelay. Does not advance the line.
+    void readBlock(float* output, std::size_t frames, float startDelay, float endDelay,
+                   DelayInterpolation mode = DelayInterpolation::LINEAR) {
+        switch (mode) {
+            case DelayInterpolation::HERMITE:
+                readRun(output, frames, startDelay, endDelay,
+                        [this](float d, std::size_t i) { return tapHermite(d, i); });
+                break;
+            case DelayInterpolation::LAGRANGE:
+                readRun(output, frames, startDelay, endDelay,
+                        [this](float d, std::size_t i) { return tapLagrange(d, i); });
+                break;
+            case DelayInterpolation::ALLPASS:
+                readRun(output, frames, startDelay, endDelay,
+                        [this](float d, std::size_t i) { return tapAllpass(d, i); });
+                break;
+            case DelayInterpolation::LINEAR:
+            default:
+                readRun(output, frames, startDelay, endDelay,
+                        [this](float d, std::size_t i) { return tapLinear(d, i); });
+                break;
+        }
+    }
 
-        return hermiteInterpolate(buffer[posm1], buffer[pos0], buffer[pos1], buffer[pos2], frac);
+    // Frames that readBlock() can produce before the first of them would
+    // depend on a sample not yet written, for the given minimum delay.
+    static std::size_t readAheadLimit(float minDelay,
+                                      DelayInterpolation mode = DelayInterpolation::LINEAR) {
+        std::size_t limit = static_cast<std::size_t>(minDelay);
+        if (mode == DelayInterpolation::HERMITE || mode == DelayInterpolation::LAGRANGE) {
+            limit -= 1;
+        } else if (mode == DelayInterpolation::ALLPASS) {
+            limit = static_cast<std::size_t>(minDelay - 0.5f);
+        }
+        return std::max<std::size_t>(limit, 1);
+    }
+
+    // Writes directly into the ring (keeping the guard mirror in sync).
+    void setSample(std::size_t index, float value) {
+        index &= mask;
+        buffer[index] = value;
+        buffer[index + (index < kGuard ? capacity : 0)] = value;
     }
 
     void reset() {
         std::fill(buffer.begin(), buffer.end(), 0.0f);
         writePos = 0;
+        allpass.reset();
     }
 
     std::size_t size() const {
@@ -105,9 +206,64 @@ public:
     }
 
 private:
-    std::vector<float> buffer;
+    struct Tap {
+        std::size_t index;
+        float frac;
+    };
+
+    // Splits a read at `delayLength` (relative to `offset` writes from now)
+    // into the ring index of the first of the interpolator's points and the
+    // fractional position between the two centre points. `before` is the
+    // number of points the interpolator needs ahead of the centre pair.
+    Tap locate(float delayLength, std::size_t before, std::size_t offset) const {
+        const std::size_t whole = static_cast<std::size_t>(delayLength);
+        const float frac = delayLength - static_cast<float>(whole);
+        return {(writePos + offset + capacity - whole - 1 - before) & mask, 1.0f - frac};
+    }
+
+    float tapLinear(float delayLength, std::size_t offset) const {
+        const Tap tap = locate(delayLength, 0, offset);
+        return lerp(buffer[tap.index], buffer[tap.index + 1], tap.frac);
+    }
+
+    float tapHermite(float delayLength, std::size_t offset) const {
+        const Tap tap = locate(delayLength, 1, offset);
+        const float* x = &buffer[tap.index];
+        return hermiteInterpolate(x[0], x[1], x[2], x[3], tap.frac);
+    }
+
+    float tapLagrange(float delayLength, std::size_t offset) const {
+        const Tap tap = locate(delayLength, 1, offset);
+        const float* x = &buffer[tap.index];
+        return lagrangeInterpolate(x[0], x[1], x[2], x[3], tap.frac);
+    }
+
+    float tapAllpass(float delayLength, std::size_t offset) {
+        const std::size_t whole = static_cast<std::size_t>(delayLength - 0.5f);
+        const float delta = delayLength - static_cast<float>(whole);
+        if (delta != allpassDelta) {
+            allpassDelta = delta;
+            allpassEta = allpassCoefficient(delta);
+        }
+        return allpass.process(buffer[(writePos + offset + capacity - whole) & mask], allpassEta);
+    }
+
+    template <class TapFn>
+    static void readRun(float* output, std::size_t frames, float startDelay, float endDelay, TapFn&& tap) {
+        const float step = frames > 0 ? (endDelay - startDelay) / static_cast<float>(frames) : 0.0f;
+        for (std::size_t i = 0; i < frames; ++i) {
+            output[i] = tap(startDelay + step * static_cast<float>(i), i);
+        }
+    }
+
     std::size_t maxLength;
+    std::size_t capacity;
+    std::size_t mask;
+    std::vector<float> buffer;
     std::size_t writePos;
+    AllpassDelay allpass;
+    float allpassDelta;
+    float allpassEta;
 };
 
 inline std::pair<float, float> calculateSafeDelayRange(float baseDelay, float modAmount,
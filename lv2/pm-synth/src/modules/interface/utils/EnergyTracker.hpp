@@ -4,6 +4,8 @@
 #include <cmath>
 #include <vector>
 
+#include "../../../DenormalGuard.hpp"
+
 namespace flues::pm {
 
 class RMSTracker {
@@ -57,7 +59,7 @@ public:
         if (rectified > peak) {
             peak = peak * attackCoeff + rectified * (1.0f - attackCoeff);
         } else {
-            peak = peak * releaseCoeff + rectified * (1.0f - releaseCoeff);
+            peak = flushDenormal(peak * releaseCoeff + rectified * (1.0f - releaseCoeff));
         }
         return peak;
     }
@@ -88,7 +90,7 @@ public:
     }
 
     float process(float sample) {
-        value = value * coefficient + sample * (1.0f - coefficient);
+        value = flushDenormal(value * coefficient + sample * (1.0f - coefficient));
         return value;
     }
 
@@ -116,7 +118,7 @@ public:
     }
 
     float process(float input) {
-        energy = energy * decayRate + std::abs(input);
+        energy = flushDenormal(energy * decayRate + std::abs(input));
         return energy;
     }
 
@@ -153,7 +155,7 @@ public:
         if (coefficient == 0.0f) {
             amplitude = instant;
         } else {
-            amplitude = amplitude * coefficient + instant * (1.0f - coefficient);
+            amplitude = flushDenormal(amplitude * coefficient + instant * (1.0f - coefficient));
         }
         return amplitude;
     }
@@ -24,17 +24,15 @@ inline std::vector<float> generateTriangularProfile(std::size_t length,
     return buffer;
 }
 
-inline std::vector<float> generateNoiseBurst(std::size_t length,
+inline std::vector<float> generateNoiseBurst(Random& rng,
+                                             std::size_t length,
                                              float amplitude = 1.0f,
-                                             float decay = 0.95f,
-                                             Random* rng = nullptr) {
-    Random local;
-    Random& random = rng ? *rng : local;
+                                             float decay = 0.95f) {
     std::vector<float> buffer(length, 0.0f);
     float envelope = 1.0f;
 
     for (std::size_t i = 0; i < length; ++i) {
-        const float noise = random.uniformSignedFloat();
+        const float noise = rng.uniformSignedFloat();
         buffer[i] = noise * amplitude * envelope;
         envelope *= decay;
     }
@@ -66,10 +64,8 @@ inline std::vector<float> generateVelocityBurst(std::size_t length,
     return buffer;
 }
 
-inline float whiteNoise(float amplitude = 1.0f, Random* rng = nullptr) {
-    Random local;
-    Random& random = rng ? *rng : local;
-    return random.uniformSignedFloat() * amplitude;
+inline float whiteNoise(Random& rng, float amplitude = 1.0f) {
+    return rng.uniformSignedFloat() * amplitude;
 }
 
 class PinkNoiseGenerator {
@@ -77,10 +73,8 @@ public:
     PinkNoiseGenerator()
         : b0(0), b1(0), b2(0), b3(0), b4(0), b5(0), b6(0) {}
 
-    float process(float amplitude = 1.0f, Random* rng = nullptr) {
-        Random local;
-        Random& random = rng ? *rng : local;
-        const float white = random.uniformSignedFloat();
+    float process(Random& rng, float amplitude = 1.0f) {
+        const float white = rng.uniformSignedFloat();
 
         b0 = 0.99886f * b0 + white * 0.0555179f;
         b1 = 0.99332f * b1 + white * 0.0750759f;
@@ -125,10 +119,8 @@ private:
     float x_;
 };
 
-inline float gaussianNoise(float mean = 0.0f, float stdDev = 1.0f, Random* rng = nullptr) {
-    Random local;
-    Random& random = rng ? *rng : local;
-    return random.normal(mean, stdDev);
+inline float gaussianNoise(Random& rng, float mean = 0.0f, float stdDev = 1.0f) {
+    return rng.normal(mean, stdDev);
 }
 
 } // namespace flues::pm
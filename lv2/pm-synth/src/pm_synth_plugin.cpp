@@ -13,6 +13,8 @@
 #include <lv2/urid/urid.h>
 
 #include "PMSynthEngine.hpp"
+#include "DenormalGuard.hpp"
+#include "PortCache.hpp"
 
 #define PMSYNTH_URI "https://danja.github.io/flues/plugins/pm-synth"
 #define PLUGIN_VERSION "v1.0.2-debug-2024-10-20"
@@ -56,9 +58,13 @@ enum PortIndex : uint32_t {
     PORT_MOD_TYPE_LEVEL,
     PORT_REVERB_SIZE,
     PORT_REVERB_LEVEL,
+    PORT_DELAY_INTERPOLATION,
+    PORT_REVERB_MODE,
     PORT_TOTAL_COUNT
 };
 
+using ControlPorts = PortCache<PORT_TOTAL_COUNT>;
+
 struct PMSynthLV2 {
     std::unique_ptr<PMSynthEngine> engine;
     float sampleRate;
@@ -66,25 +72,7 @@ struct PMSynthLV2 {
     const LV2_Atom_Sequence* midiIn;
     float* audioOut;
 
-    const float* dcLevel;
-    const float* noiseLevel;
-    const float* toneLevel;
-    const float* attack;
-    const float* release;
-    const float* interfaceType;
-    const float* interfaceIntensity;
-    const float* tuning;
-    const float* ratio;
-    const float* delay1Feedback;
-    const float* delay2Feedback;
-    const float* filterFeedback;
-    const float* filterFrequency;
-    const float* filterQ;
-    const float* filterShape;
-    const float* lfoFrequency;
-    const float* modulationTypeLevel;
-    const float* reverbSize;
-    const float* reverbLevel;
+    ControlPorts controls;
 
     LV2_URID_Map* map;
     LV2_URID midiEventUrid;
@@ -98,34 +86,41 @@ static void apply_parameters(PMSynthLV2* self) {
         return;
     }
 
-    auto apply = [&](const float* port, auto setter) {
-        if (port) {
-            (self->engine.get()->*setter)(*port);
+    const ControlPorts::Mask dirty = self->controls.poll();
+    if (!dirty) {
+        return;
+    }
+
+    auto apply = [&](uint32_t port, auto setter) {
+        if (dirty & ControlPorts::bit(port)) {
+            (self->engine.get()->*setter)(self->controls.value(port));
         }
     };
 
-    apply(self->dcLevel, &PMSynthEngine::setDCLevel);
-    apply(self->noiseLevel, &PMSynthEngine::setNoiseLevel);
-    apply(self->toneLevel, &PMSynthEngine::setToneLevel);
-    apply(self->attack, &PMSynthEngine::setAttack);
-    apply(self->release, &PMSynthEngine::setRelease);
-
-    if (self->interfaceType) {
-        self->engine->setInterfaceType(*self->interfaceType);
+    apply(PORT_DC_LEVEL, &PMSynthEngine::setDCLevel);
+    apply(PORT_NOISE_LEVEL, &PMSynthEngine::setNoiseLevel);
+    apply(PORT_TONE_LEVEL, &PMSynthEngine::setToneLevel);
+    apply(PORT_ATTACK, &PMSynthEngine::setAttack);
+    apply(PORT_RELEASE, &PMSynthEngine::setRelease);
+
+    apply(PORT_INTERFACE_TYPE, &PMSynthEngine::setInterfaceType);
+    apply(PORT_INTERFACE_INTENSITY, &PMSynthEngine::setInterfaceIntensity);
+    // Tuning and ratio both re-derive the delay lengths; update them together.
+    if (dirty & (ControlPorts::bit(PORT_TUNING) | ControlPorts::bit(PORT_RATIO))) {
+        self->engine->setTuningAndRatio(self->controls.value(PORT_TUNING), self->controls.value(PORT_RATIO));
     }
-    apply(self->interfaceIntensity, &PMSynthEngine::setInterfaceIntensity);
-    apply(self->tuning, &PMSynthEngine::setTuning);
-    apply(self->ratio, &PMSynthEngine::setRatio);
-    apply(self->delay1Feedback, &PMSynthEngine::setDelay1Feedback);
-    apply(self->delay2Feedback, &PMSynthEngine::setDelay2Feedback);
-    apply(self->filterFeedback, &PMSynthEngine::setFilterFeedback);
-    apply(self->filterFrequency, &PMSynthEngine::setFilterFrequency);
-    apply(self->filterQ, &PMSynthEngine::setFilterQ);
-    apply(self->filterShape, &PMSynthEngine::setFilterShape);
-    apply(self->lfoFrequency, &PMSynthEngine::setLFOFrequency);
-    apply(self->modulationTypeLevel, &PMSynthEngine::setModulationTypeLevel);
-    apply(self->reverbSize, &PMSynthEngine::setReverbSize);
-    apply(self->reverbLevel, &PMSynthEngine::setReverbLevel);
+    apply(PORT_DELAY1_FEEDBACK, &PMSynthEngine::setDelay1Feedback);
+    apply(PORT_DELAY2_FEEDBACK, &PMSynthEngine::setDelay2Feedback);
+    apply(PORT_FILTER_FEEDBACK, &PMSynthEngine::setFilterFeedback);
+    apply(PORT_FILTER_FREQUENCY, &PMSynthEngine::setFilterFrequency);
+    apply(PORT_FILTER_Q, &PMSynthEngine::setFilterQ);
+    apply(PORT_FILTER_SHAPE, &PMSynthEngine::setFilterShape);
+    apply(PORT_LFO_FREQUENCY, &PMSynthEngine::setLFOFrequency);
+    apply(PORT_MOD_TYPE_LEVEL, &PMSynthEngine::setModulationTypeLevel);
+    apply(PORT_REVERB_SIZE, &PMSynthEngine::setReverbSize);
+    apply(PORT_REVERB_LEVEL, &PMSynthEngine::setReverbLevel);
+    apply(PORT_DELAY_INTERPOLATION, &PMSynthEngine::setDelayInterpolation);
+    apply(PORT_REVERB_MODE, &PMSynthEngine::setReverbMode);
 }
 
 static void handle_midi(PMSynthLV2* self, const uint8_t* msg, uint32_t size) {
@@ -184,32 +179,15 @@ static LV2_Handle instantiate(const LV2_Descriptor*, double rate,
 
     auto* self = new PMSynthLV2();
     self->sampleRate = static_cast<float>(rate);
+    // Built here, off the audio thread. The constructors zero-fill every
+    // delay and reverb buffer, which also faults their pages in, so
+    // activate() and run() never touch fresh memory.
     self->engine = std::make_unique<PMSynthEngine>(self->sampleRate);
 
     std::fprintf(stderr, LOG_PREFIX "  Engine created successfully\n");
     self->midiIn = nullptr;
     self->audioOut = nullptr;
 
-    self->dcLevel = nullptr;
-    self->noiseLevel = nullptr;
-    self->toneLevel = nullptr;
-    self->attack = nullptr;
-    self->release = nullptr;
-    self->interfaceType = nullptr;
-    self->interfaceIntensity = nullptr;
-    self->tuning = nullptr;
-    self->ratio = nullptr;
-    self->delay1Feedback = nullptr;
-    self->delay2Feedback = nullptr;
-    self->filterFeedback = nullptr;
-    self->filterFrequency = nullptr;
-    self->filterQ = nullptr;
-    self->filterShape = nullptr;
-    self->lfoFrequency = nullptr;
-    self->modulationTypeLevel = nullptr;
-    self->reverbSize = nullptr;
-    self->reverbLevel = nullptr;
-
     self->map = nullptr;
     self->midiEventUrid = 0;
     self->currentNote = -1;
@@ -248,35 +226,18 @@ static void connect_port(LV2_Handle instance, uint32_t port, void* data) {
     switch (port) {
         case PORT_AUDIO_OUT: self->audioOut = static_cast<float*>(data); break;
         case PORT_MIDI_IN: self->midiIn = static_cast<const LV2_Atom_Sequence*>(data); break;
-        case PORT_DC_LEVEL: self->dcLevel = static_cast<const float*>(data); break;
-        case PORT_NOISE_LEVEL: self->noiseLevel = static_cast<const float*>(data); break;
-        case PORT_TONE_LEVEL: self->toneLevel = static_cast<const float*>(data); break;
-        case PORT_ATTACK: self->attack = static_cast<const float*>(data); break;
-        case PORT_RELEASE: self->release = static_cast<const float*>(data); break;
-        case PORT_INTERFACE_TYPE: self->interfaceType = static_cast<const float*>(data); break;
-        case PORT_INTERFACE_INTENSITY: self->interfaceIntensity = static_cast<const float*>(data); break;
-        case PORT_TUNING: self->tuning = static_cast<const float*>(data); break;
-        case PORT_RATIO: self->ratio = static_cast<const float*>(data); break;
-        case PORT_DELAY1_FEEDBACK: self->delay1Feedback = static_cast<const float*>(data); break;
-        case PORT_DELAY2_FEEDBACK: self->delay2Feedback = static_cast<const float*>(data); break;
-        case PORT_FILTER_FEEDBACK: self->filterFeedback = static_cast<const float*>(data); break;
-        case PORT_FILTER_FREQUENCY: self->filterFrequency = static_cast<const float*>(data); break;
-        case PORT_FILTER_Q: self->filterQ = static_cast<const float*>(data); break;
-        case PORT_FILTER_SHAPE: self->filterShape = static_cast<const float*>(data); break;
-        case PORT_LFO_FREQUENCY: self->lfoFrequency = static_cast<const float*>(data); break;
-        case PORT_MOD_TYPE_LEVEL: self->modulationTypeLevel = static_cast<const float*>(data); break;
-        case PORT_REVERB_SIZE: self->reverbSize = static_cast<const float*>(data); break;
-        case PORT_REVERB_LEVEL: self->reverbLevel = static_cast<const float*>(data); break;
-        default: break;
+        default: self->controls.connect(port, static_cast<const float*>(data)); break;
     }
 }
 
 static void activate(LV2_Handle instance) {
     auto* self = static_cast<flues::pm::PMSynthLV2*>(instance);
-    if (!self) {
+    if (!self || !self->engine) {
         return;
     }
-    self->engine = std::make_unique<flues::pm::PMSynthEngine>(self->sampleRate);
+    // Clears the engine in place; the parameters it already holds stay in
+    // step with the port cache.
+    self->engine->resetAll();
     self->currentNote = -1;
 }
 
@@ -287,10 +248,12 @@ static void run(LV2_Handle instance, uint32_t n_samples) {
         return;
     }
 
+    // FTZ/DAZ for the whole cycle; the host's mode is restored on return.
+    const DenormalGuard denormalGuard;
+
     apply_parameters(self);
 
     float* out = self->audioOut;
-    std::memset(out, 0, n_samples * sizeof(float));
 
     uint32_t frame = 0;
 
@@ -302,9 +265,8 @@ static void run(LV2_Handle instance, uint32_t n_samples) {
 
             if (frame < eventFrame) {
                 const uint32_t limit = std::min(eventFrame, n_samples);
-                for (; frame < limit; ++frame) {
-                    out[frame] = self->engine->process();
-                }
+                self->engine->processBlock(out + frame, limit - frame);
+                frame = limit;
             }
 
             if (ev->body.type == self->midiEventUrid) {
@@ -314,8 +276,8 @@ static void run(LV2_Handle instance, uint32_t n_samples) {
         }
     }
 
-    for (; frame < n_samples; ++frame) {
-        out[frame] = self->engine->process();
+    if (frame < n_samples) {
+        self->engine->processBlock(out + frame, n_samples - frame);
     }
 }
 
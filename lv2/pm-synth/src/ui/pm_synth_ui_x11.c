@@ -52,6 +52,8 @@ typedef enum {
     PORT_MOD_TYPE_LEVEL,
     PORT_REVERB_SIZE,
     PORT_REVERB_LEVEL,
+    PORT_DELAY_INTERPOLATION,
+    PORT_REVERB_MODE,
     PORT_TOTAL_COUNT
 } PortIndex;
 
@@ -91,6 +93,7 @@ static const ControlDesc kControlInfo[] = {
     { GROUP_PIPE, "RATIO", PORT_RATIO, 0.0f, 1.0f, 0.5f, 0 },
     { GROUP_PIPE, "DELAY 1 FB", PORT_DELAY1_FEEDBACK, 0.0f, 1.0f, 0.95959598f, 0 },
     { GROUP_PIPE, "DELAY 2 FB", PORT_DELAY2_FEEDBACK, 0.0f, 1.0f, 0.95959598f, 0 },
+    { GROUP_PIPE, "INTERP", PORT_DELAY_INTERPOLATION, 0.0f, 3.0f, 0.0f, 4 },
 
     { GROUP_FILTER, "FILTER FB", PORT_FILTER_FEEDBACK, 0.0f, 1.0f, 0.0f, 0 },
     { GROUP_FILTER, "FILTER FREQ", PORT_FILTER_FREQUENCY, 0.0f, 1.0f, 0.56632334f, 0 },
@@ -102,6 +105,7 @@ static const ControlDesc kControlInfo[] = {
 
     { GROUP_REVERB, "SIZE", PORT_REVERB_SIZE, 0.0f, 1.0f, 0.5f, 0 },
     { GROUP_REVERB, "LEVEL", PORT_REVERB_LEVEL, 0.0f, 1.0f, 0.3f, 0 },
+    { GROUP_REVERB, "MODE", PORT_REVERB_MODE, 0.0f, 1.0f, 0.0f, 2 },
 };
 
 typedef struct {
@@ -113,10 +117,10 @@ static const GroupLayout kGroupLayout[GROUP_COUNT] = {
     [GROUP_STEAM] = { 0, 3 },
     [GROUP_INTERFACE] = { 0, 2 },
     [GROUP_ENVELOPE] = { 0, 2 },
-    [GROUP_PIPE] = { 1, 4 },
+    [GROUP_PIPE] = { 1, 5 },
     [GROUP_FILTER] = { 1, 4 },
     [GROUP_MODULATION] = { 2, 2 },
-    [GROUP_REVERB] = { 2, 2 },
+    [GROUP_REVERB] = { 2, 3 },
 };
 
 static const GroupIndex kRowGroups[][4] = {